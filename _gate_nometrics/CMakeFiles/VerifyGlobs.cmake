@@ -0,0 +1,32 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by CMake Version 3.25
+cmake_policy(SET CMP0009 NEW)
+
+# MASTERMIND_TEST_SOURCES at CMakeLists.txt:58 (file)
+file(GLOB NEW_GLOB LIST_DIRECTORIES true "/root/repo/test/*.cpp")
+set(OLD_GLOB
+  "/root/repo/test/main_test.cpp"
+  "/root/repo/test/mastermind_anytime_solver_test.cpp"
+  "/root/repo/test/mastermind_basic_code_pattern_generator_test.cpp"
+  "/root/repo/test/mastermind_coalescing_front_end_test.cpp"
+  "/root/repo/test/mastermind_code_space_test.cpp"
+  "/root/repo/test/mastermind_consistency_engine_test.cpp"
+  "/root/repo/test/mastermind_difficulty_index_test.cpp"
+  "/root/repo/test/mastermind_engine_snapshot_test.cpp"
+  "/root/repo/test/mastermind_engine_test.cpp"
+  "/root/repo/test/mastermind_game_log_test.cpp"
+  "/root/repo/test/mastermind_game_test.cpp"
+  "/root/repo/test/mastermind_metrics_test.cpp"
+  "/root/repo/test/mastermind_perf_counters_test.cpp"
+  "/root/repo/test/mastermind_sampling_solver_test.cpp"
+  "/root/repo/test/mastermind_shard_runner_test.cpp"
+  "/root/repo/test/mastermind_shared_challenge_test.cpp"
+  "/root/repo/test/mastermind_shm_transport_test.cpp"
+  "/root/repo/test/mastermind_static_solver_test.cpp"
+  "/root/repo/test/mastermind_utils_test.cpp"
+  "/root/repo/test/win_cmd_script_ui_test.cpp"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_gate_nometrics/CMakeFiles/cmake.verify_globs")
+endif()
@@ -0,0 +1,39 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/main_test.cpp" "CMakeFiles/mastermind_tests.dir/test/main_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/main_test.cpp.o.d"
+  "/root/repo/test/mastermind_anytime_solver_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_anytime_solver_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_anytime_solver_test.cpp.o.d"
+  "/root/repo/test/mastermind_basic_code_pattern_generator_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_basic_code_pattern_generator_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_basic_code_pattern_generator_test.cpp.o.d"
+  "/root/repo/test/mastermind_coalescing_front_end_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_coalescing_front_end_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_coalescing_front_end_test.cpp.o.d"
+  "/root/repo/test/mastermind_code_space_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_code_space_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_code_space_test.cpp.o.d"
+  "/root/repo/test/mastermind_consistency_engine_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_consistency_engine_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_consistency_engine_test.cpp.o.d"
+  "/root/repo/test/mastermind_difficulty_index_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_difficulty_index_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_difficulty_index_test.cpp.o.d"
+  "/root/repo/test/mastermind_engine_snapshot_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_engine_snapshot_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_engine_snapshot_test.cpp.o.d"
+  "/root/repo/test/mastermind_engine_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_engine_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_engine_test.cpp.o.d"
+  "/root/repo/test/mastermind_game_log_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_game_log_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_game_log_test.cpp.o.d"
+  "/root/repo/test/mastermind_game_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_game_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_game_test.cpp.o.d"
+  "/root/repo/test/mastermind_metrics_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_metrics_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_metrics_test.cpp.o.d"
+  "/root/repo/test/mastermind_perf_counters_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_perf_counters_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_perf_counters_test.cpp.o.d"
+  "/root/repo/test/mastermind_sampling_solver_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_sampling_solver_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_sampling_solver_test.cpp.o.d"
+  "/root/repo/test/mastermind_shard_runner_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_shard_runner_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_shard_runner_test.cpp.o.d"
+  "/root/repo/test/mastermind_shared_challenge_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_shared_challenge_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_shared_challenge_test.cpp.o.d"
+  "/root/repo/test/mastermind_shm_transport_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_shm_transport_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_shm_transport_test.cpp.o.d"
+  "/root/repo/test/mastermind_static_solver_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_static_solver_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_static_solver_test.cpp.o.d"
+  "/root/repo/test/mastermind_utils_test.cpp" "CMakeFiles/mastermind_tests.dir/test/mastermind_utils_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/mastermind_utils_test.cpp.o.d"
+  "/root/repo/test/win_cmd_script_ui_test.cpp" "CMakeFiles/mastermind_tests.dir/test/win_cmd_script_ui_test.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/test/win_cmd_script_ui_test.cpp.o.d"
+  "/root/repo/ui/win_cmd_ui/win_cmd_script_ui.cpp" "CMakeFiles/mastermind_tests.dir/ui/win_cmd_ui/win_cmd_script_ui.cpp.o" "gcc" "CMakeFiles/mastermind_tests.dir/ui/win_cmd_ui/win_cmd_script_ui.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,51 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mastermind_tests.dir/test/main_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/main_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_anytime_solver_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_anytime_solver_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_basic_code_pattern_generator_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_basic_code_pattern_generator_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_coalescing_front_end_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_coalescing_front_end_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_code_space_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_code_space_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_consistency_engine_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_consistency_engine_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_difficulty_index_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_difficulty_index_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_engine_snapshot_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_engine_snapshot_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_engine_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_engine_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_game_log_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_game_log_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_game_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_game_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_metrics_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_metrics_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_perf_counters_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_perf_counters_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_sampling_solver_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_sampling_solver_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_shard_runner_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_shard_runner_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_shared_challenge_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_shared_challenge_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_shm_transport_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_shm_transport_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_static_solver_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_static_solver_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_utils_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/mastermind_utils_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/test/win_cmd_script_ui_test.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/test/win_cmd_script_ui_test.cpp.o.d"
+  "CMakeFiles/mastermind_tests.dir/ui/win_cmd_ui/win_cmd_script_ui.cpp.o"
+  "CMakeFiles/mastermind_tests.dir/ui/win_cmd_ui/win_cmd_script_ui.cpp.o.d"
+  "mastermind_tests"
+  "mastermind_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mastermind_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
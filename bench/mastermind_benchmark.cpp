@@ -0,0 +1,366 @@
+#include "mastermind_anytime_solver.hpp"
+#include "mastermind_basic_code_pattern_generator.hpp"
+#include "mastermind_engine.hpp"
+#include "mastermind_game.hpp"
+#include "mastermind_metrics.hpp"
+#include "mastermind_perf_counters.hpp"
+#include "mastermind_shared_challenge.hpp"
+#include "mastermind_ui.hpp"
+#include "mastermind_utils.hpp"
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifndef _WIN32
+#include "mastermind_engine_snapshot.hpp"
+#include "mastermind_shm_transport.hpp"
+#endif
+
+
+namespace {
+
+    template<typename Item>
+    Item make_value(size_t i) {
+        if constexpr (std::is_same_v<Item, std::string>) {
+            return "color-" + std::to_string(i);
+        }
+        else {
+            return static_cast<Item>(i + 1);
+        }
+    }
+
+    template<typename Item>
+    std::vector<Item> make_code(size_t size, size_t offset = 0) {
+        std::vector<Item> code{};
+        code.reserve(size);
+        for (size_t i{ 0 }; i < size; ++i) {
+            code.push_back(make_value<Item>(offset + i));
+        }
+        return code;
+    }
+
+    template<typename Item>
+    std::vector<Item> rotated(std::vector<Item> code) {
+        std::rotate(code.begin(), code.begin() + 1, code.end());
+        return code;
+    }
+
+    class perf_counters_report {
+    public:
+        perf_counters_report() : m_begin{ mastermind::perf_counter_group::this_thread().read() } {
+        }
+
+        void finish(benchmark::State& state) const {
+            const mastermind::perf_counter_group& group = mastermind::perf_counter_group::this_thread();
+            if (!group.is_available()) {
+                return;
+            }
+
+            mastermind::perf_counter_values delta = group.read() - m_begin;
+            state.counters["cycles"] = benchmark::Counter(static_cast<double>(delta.cycles), benchmark::Counter::kAvgIterations);
+            state.counters["instructions"] = benchmark::Counter(static_cast<double>(delta.instructions), benchmark::Counter::kAvgIterations);
+            state.counters["cache_misses"] = benchmark::Counter(static_cast<double>(delta.cache_misses), benchmark::Counter::kAvgIterations);
+            state.counters["branch_misses"] = benchmark::Counter(static_cast<double>(delta.branch_misses), benchmark::Counter::kAvgIterations);
+        }
+
+    private:
+        mastermind::perf_counter_values m_begin;
+    };
+
+    class scripted_ui : public mastermind::mastermind_ui<int> {
+    public:
+        scripted_ui(size_t code_size, std::vector<std::vector<int>> guesses)
+            : m_code_size{ code_size }, m_guesses{ std::move(guesses) } {
+        }
+        void show_board() override {}
+        void show_tries_left(size_t) override {}
+        void show_game_result(mastermind::game_result) override {}
+        void show_lost_message() override {}
+        void show_winning_message() override {}
+        mastermind::game_start_params get_start_params() override { return { m_code_size, m_guesses.size() }; }
+        std::vector<int> ask_for_solution() override { return m_guesses[m_next++ % m_guesses.size()]; }
+        bool ask_play_again() override { return false; }
+
+    private:
+        size_t m_code_size;
+        std::vector<std::vector<int>> m_guesses;
+        size_t m_next{ 0 };
+    };
+
+}
+
+
+template<typename Item>
+static void BM_compute_game_result(benchmark::State& state) {
+    const size_t code_size = static_cast<size_t>(state.range(0));
+    const std::vector<Item> secret = make_code<Item>(code_size);
+    const std::vector<Item> guess = rotated(secret);
+
+    perf_counters_report counters{};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mastermind::compute_game_result(secret, guess));
+    }
+    counters.finish(state);
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Item>
+static void BM_compute_game_result_with_repeats(benchmark::State& state) {
+    const size_t code_size = static_cast<size_t>(state.range(0));
+    const size_t colors = static_cast<size_t>(state.range(1));
+    std::vector<Item> secret{};
+    std::vector<Item> guess{};
+    for (size_t i{ 0 }; i < code_size; ++i) {
+        secret.push_back(make_value<Item>(i % colors));
+        guess.push_back(make_value<Item>((i * 7 + 3) % colors));
+    }
+
+    perf_counters_report counters{};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mastermind::compute_game_result_with_repeats(secret, guess));
+    }
+    counters.finish(state);
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Item>
+static void BM_are_all_values_different(benchmark::State& state) {
+    const std::vector<Item> code = make_code<Item>(static_cast<size_t>(state.range(0)));
+
+    perf_counters_report counters{};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mastermind::are_all_values_different(code));
+    }
+    counters.finish(state);
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Item>
+static void BM_basic_code_pattern_generator(benchmark::State& state) {
+    const size_t code_size = static_cast<size_t>(state.range(0));
+    mastermind::basic_code_pattern_generator<Item> generator{ make_code<Item>(2 * code_size) };
+
+    perf_counters_report counters{};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(generator(code_size));
+    }
+    counters.finish(state);
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Item>
+static void BM_engine_check_solution(benchmark::State& state) {
+    const size_t code_size = static_cast<size_t>(state.range(0));
+    const std::vector<Item> secret = make_code<Item>(code_size);
+    const std::vector<Item> guess = rotated(secret);
+    mastermind::mastermind_engine<Item> engine{ [&secret](size_t) { return secret; } };
+
+    perf_counters_report counters{};
+    for (auto _ : state) {
+        engine.start_game({ code_size, 1 });
+        benchmark::DoNotOptimize(engine.check_solution(guess));
+    }
+    counters.finish(state);
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Every thread scores its own guesses against one challenge, which thread 0 builds
+// before the threads start timing together.
+template<typename Item>
+static void BM_shared_challenge_score_guesses(benchmark::State& state) {
+    static std::unique_ptr<mastermind::shared_challenge<Item>> challenge{};
+    const size_t code_size = static_cast<size_t>(state.range(0));
+    const size_t batch{ 1024 };
+    if (state.thread_index() == 0) {
+        challenge = std::make_unique<mastermind::shared_challenge<Item>>(make_code<Item>(code_size), 1);
+    }
+    std::vector<Item> guesses{};
+    for (size_t k{ 0 }; k < batch; ++k) {
+        const std::vector<Item> guess = make_code<Item>(code_size, k % (code_size + 1));
+        guesses.insert(guesses.end(), guess.begin(), guess.end());
+    }
+    std::vector<mastermind::game_result> results(batch);
+
+    perf_counters_report counters{};
+    for (auto _ : state) {
+        challenge->score_guesses(guesses.data(), batch, results.data());
+        benchmark::DoNotOptimize(results.data());
+    }
+    counters.finish(state);
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+static void BM_anytime_solver_next_guess(benchmark::State& state) {
+    const std::chrono::microseconds budget{ state.range(0) };
+    const std::vector<int> code_set = make_code<int>(20);
+    const std::vector<int> secret = rotated(make_code<int>(8));
+    const std::vector<int> first = make_code<int>(8, 4);
+    mastermind::anytime_solver<int> solver{ code_set, { 8, 20 }, {}, 1 };
+    solver.add_feedback(first, mastermind::compute_game_result(secret, first));
+
+    double coverage{ 0 };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(solver.next_guess(budget));
+        coverage += solver.get_progress().get_consistent_coverage();
+    }
+    state.counters["consistent_coverage"] = coverage / static_cast<double>(state.iterations());
+    state.counters["guesses_scored"] = static_cast<double>(solver.get_progress().get_guesses_scored());
+}
+
+static void BM_game_round_trip(benchmark::State& state) {
+    const size_t code_size = static_cast<size_t>(state.range(0));
+    const std::vector<int> secret = make_code<int>(code_size);
+    std::vector<std::vector<int>> guesses{ make_code<int>(code_size, code_size), rotated(secret), make_code<int>(code_size, 1), secret };
+
+    perf_counters_report counters{};
+    for (auto _ : state) {
+        scripted_ui ui{ code_size, guesses };
+        mastermind::mastermind_game<mastermind::mastermind_engine<int>> game{ ui, [&secret](size_t) { return secret; } };
+        game.run();
+    }
+    counters.finish(state);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(guesses.size()));
+}
+
+#ifndef _WIN32
+static std::vector<mastermind::mastermind_engine<int>> make_sessions(size_t count) {
+    std::vector<mastermind::mastermind_engine<int>> sessions{};
+    sessions.reserve(count);
+    for (size_t i{ 0 }; i < count; ++i) {
+        std::vector<int> secret = make_code<int>(4, i % 8);
+        sessions.emplace_back([secret](size_t) { return secret; });
+        sessions.back().start_game({ 4, 10 });
+        sessions.back().check_solution(make_code<int>(4, 1));
+    }
+    return sessions;
+}
+
+static void BM_engine_snapshot_save(benchmark::State& state) {
+    const auto sessions = make_sessions(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        mastermind::engine_snapshot_writer<int> writer{};
+        for (const auto& session : sessions) {
+            writer.add(session);
+        }
+        benchmark::DoNotOptimize(writer.serialize());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_engine_snapshot_restore(benchmark::State& state) {
+    auto sessions = make_sessions(static_cast<size_t>(state.range(0)));
+    mastermind::engine_snapshot_writer<int> writer{};
+    for (const auto& session : sessions) {
+        writer.add(session);
+    }
+    const std::vector<unsigned char> buffer = writer.serialize();
+
+    for (auto _ : state) {
+        mastermind::engine_snapshot_view<int> view{ buffer.data(), buffer.size() };
+        for (size_t i{ 0 }; i < view.size(); ++i) {
+            view.restore(i, sessions[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_shm_round_trip(benchmark::State& state) {
+    const std::vector<int> secret = make_code<int>(4);
+    const std::string name{ "/mastermind_benchmark_" + std::to_string(::getpid()) };
+    mastermind::shm_channel server_channel{ name, 1024 };
+    mastermind::shm_channel client_channel{ name };
+    mastermind::shm_engine_server<int> server{ server_channel, [&secret](size_t) { return secret; } };
+    mastermind::shm_bot_client client{ client_channel };
+    std::atomic<bool> stop{ false };
+    std::thread server_thread{ [&]() { server.serve(stop); } };
+
+    client.start_game(0, { 4, 1u << 30 });
+    const std::vector<int> guess = rotated(secret);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(client.guess(0, guess));
+    }
+    stop = true;
+    server_thread.join();
+    state.SetItemsProcessed(state.iterations());
+}
+#endif
+
+static void BM_count_metric(benchmark::State& state) {
+    perf_counters_report counters{};
+    for (auto _ : state) {
+        mastermind::count_metric(mastermind::metric_counter::GUESSES_SCORED);
+    }
+    counters.finish(state);
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_scoped_latency(benchmark::State& state) {
+    perf_counters_report counters{};
+    for (auto _ : state) {
+        mastermind::scoped_latency latency{ mastermind::metric_histogram::CHECK_SOLUTION_LATENCY };
+    }
+    counters.finish(state);
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define MASTERMIND_CODE_SIZES RangeMultiplier(2)->Range(4, 32)
+
+BENCHMARK_TEMPLATE(BM_compute_game_result, int)->MASTERMIND_CODE_SIZES;
+BENCHMARK_TEMPLATE(BM_compute_game_result, char)->MASTERMIND_CODE_SIZES;
+BENCHMARK_TEMPLATE(BM_compute_game_result, std::uint64_t)->MASTERMIND_CODE_SIZES;
+BENCHMARK_TEMPLATE(BM_compute_game_result, std::string)->MASTERMIND_CODE_SIZES;
+
+BENCHMARK_TEMPLATE(BM_compute_game_result_with_repeats, int)->ArgsProduct({ { 4, 8, 16, 32 }, { 6, 64, 1024 } });
+BENCHMARK_TEMPLATE(BM_compute_game_result_with_repeats, char)->ArgsProduct({ { 4, 8, 16, 32 }, { 6, 64 } });
+BENCHMARK_TEMPLATE(BM_compute_game_result_with_repeats, std::string)->ArgsProduct({ { 4, 8, 16, 32 }, { 6 } });
+
+BENCHMARK_TEMPLATE(BM_are_all_values_different, int)->MASTERMIND_CODE_SIZES;
+BENCHMARK_TEMPLATE(BM_are_all_values_different, char)->MASTERMIND_CODE_SIZES;
+BENCHMARK_TEMPLATE(BM_are_all_values_different, std::uint64_t)->MASTERMIND_CODE_SIZES;
+BENCHMARK_TEMPLATE(BM_are_all_values_different, std::string)->MASTERMIND_CODE_SIZES;
+
+BENCHMARK_TEMPLATE(BM_basic_code_pattern_generator, int)->MASTERMIND_CODE_SIZES;
+BENCHMARK_TEMPLATE(BM_basic_code_pattern_generator, char)->MASTERMIND_CODE_SIZES;
+BENCHMARK_TEMPLATE(BM_basic_code_pattern_generator, std::uint64_t)->MASTERMIND_CODE_SIZES;
+BENCHMARK_TEMPLATE(BM_basic_code_pattern_generator, std::string)->MASTERMIND_CODE_SIZES;
+
+BENCHMARK_TEMPLATE(BM_engine_check_solution, int)->MASTERMIND_CODE_SIZES;
+BENCHMARK_TEMPLATE(BM_engine_check_solution, std::string)->MASTERMIND_CODE_SIZES;
+
+BENCHMARK_TEMPLATE(BM_shared_challenge_score_guesses, int)->MASTERMIND_CODE_SIZES->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_shared_challenge_score_guesses, std::string)->MASTERMIND_CODE_SIZES->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK(BM_anytime_solver_next_guess)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK(BM_game_round_trip)->MASTERMIND_CODE_SIZES;
+
+#ifndef _WIN32
+BENCHMARK(BM_engine_snapshot_save)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_engine_snapshot_restore)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_shm_round_trip)->UseRealTime();
+#endif
+
+BENCHMARK(BM_count_metric);
+BENCHMARK(BM_scoped_latency);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    mastermind::perf_registry::instance().report(std::cerr);
+}
@@ -0,0 +1,296 @@
+#pragma once
+
+#include "mastermind_consistency_engine.hpp"
+#include "mastermind_exceptions.hpp"
+#include "mastermind_perf_counters.hpp"
+#include "mastermind_utils.hpp"
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <set>
+#include <vector>
+
+
+namespace mastermind {
+
+    struct anytime_solver_options {
+        size_t max_secrets{ 2048 };
+        size_t max_representatives{ 4096 };
+        size_t sampled_guesses{ 512 };
+        size_t search_node_limit{ 1 << 20 };
+    };
+
+    // What one next_guess call managed to do before its deadline.
+    struct anytime_progress {
+        size_t secrets{ 0 };
+        bool secrets_complete{ false };
+        size_t search_nodes{ 0 };
+        size_t consistent_scored{ 0 };
+        size_t representatives_scored{ 0 };
+        bool representatives_complete{ false };
+        size_t sampled_scored{ 0 };
+        size_t best_score{ SIZE_MAX };
+        bool deadline_reached{ false };
+        std::chrono::nanoseconds elapsed{ 0 };
+
+        size_t get_guesses_scored() const { return consistent_scored + representatives_scored + sampled_scored; }
+        double get_consistent_coverage() const { return (secrets == 0) ? 0.0 : static_cast<double>(consistent_scored) / static_cast<double>(secrets); }
+    };
+
+    // Solver that answers within a deadline. It collects up to max_secrets codes
+    // consistent with the feedback and scores guesses by the sum of the squared sizes
+    // of the partitions they split those secrets into, in priority order: the
+    // consistent codes themselves, then one representative per class of codes equal up
+    // to a permutation of the colors not played yet, then random codes. The best guess
+    // so far is returned as soon as the deadline passes, also during the search for
+    // secrets. At least one code is always returned: a consistent one if the search met
+    // any within its first consistency_engine::stop_check_interval nodes, otherwise a
+    // random one, so an answer exists even for a deadline already in the past.
+    template<typename Item>
+    class anytime_solver {
+    public:
+        typedef Item value_type;
+        typedef std::chrono::steady_clock clock_type;
+        typedef std::function<void(const anytime_progress&)> progress_callback_type;
+
+        anytime_solver(const std::vector<Item>& code_set, game_start_params start_params,
+            anytime_solver_options options = {}, std::uint_fast32_t seed = std::random_device{}());
+
+        std::vector<Item> next_guess(clock_type::time_point deadline);
+        std::vector<Item> next_guess(std::chrono::microseconds budget) { return next_guess(clock_type::now() + budget); }
+        void add_feedback(const std::vector<Item>& guess, game_result result);
+
+        const anytime_progress& get_progress() const { return m_progress; }
+        void set_progress_callback(progress_callback_type callback) { m_progress_callback = std::move(callback); }
+
+    private:
+        typedef std::vector<size_t> code_type;
+        typedef consistency_engine<size_t>::domain_type mask_type;
+
+        std::vector<Item> m_code_set;
+        size_t m_code_size;
+        anytime_solver_options m_options;
+        consistency_engine<size_t> m_consistency;
+        mask_type m_played{ 0 };
+        std::mt19937 m_generator;
+        anytime_progress m_progress{};
+        progress_callback_type m_progress_callback{};
+
+        std::vector<Item> to_items(const code_type& code) const;
+        code_type random_code();
+        void canonicalize(code_type& code) const;
+        static mask_type mask_of(const code_type& code);
+    };
+
+    template<typename Item>
+    anytime_solver<Item>::anytime_solver(const std::vector<Item>& code_set, game_start_params start_params,
+        anytime_solver_options options, std::uint_fast32_t seed)
+        : m_code_set{ code_set }, m_code_size{ start_params.code_size }, m_options{ options },
+        m_consistency{ [&code_set]() {
+            code_type colors(code_set.size());
+            for (size_t i{ 0 }; i < colors.size(); ++i) {
+                colors[i] = i;
+            }
+            return colors;
+        }(), start_params },
+        m_generator{ static_cast<std::mt19937::result_type>(seed) } {
+        if (!are_all_values_different(m_code_set)) {
+            throw indistinct_values_error();
+        }
+        m_options.max_secrets = std::max<size_t>(m_options.max_secrets, 1);
+        m_consistency.set_node_limit(m_options.search_node_limit);
+    }
+
+    template<typename Item>
+    std::vector<Item> anytime_solver<Item>::next_guess(clock_type::time_point deadline) {
+        MASTERMIND_PERF_SCOPE("anytime_solver.next_guess");
+        const clock_type::time_point start = clock_type::now();
+        m_progress = {};
+
+        std::vector<code_type> secrets{};
+        bool stopped{ false };
+        m_consistency.for_each_consistent(m_generator, [&](const code_type& code) {
+            secrets.push_back(code);
+            stopped = secrets.size() >= m_options.max_secrets || clock_type::now() >= deadline;
+            return !stopped;
+        }, [&deadline]() { return clock_type::now() >= deadline; });
+        m_progress.secrets = secrets.size();
+        m_progress.secrets_complete = !stopped && !m_consistency.is_search_truncated();
+        m_progress.search_nodes = m_consistency.get_nodes_visited();
+
+        code_type best{};
+        if (secrets.size() <= 1) {
+            best = secrets.empty() ? random_code() : secrets.front();
+            m_progress.consistent_scored = secrets.size();
+        }
+        else {
+            std::vector<mask_type> secret_masks{};
+            secret_masks.reserve(secrets.size());
+            for (const code_type& secret : secrets) {
+                secret_masks.push_back(mask_of(secret));
+            }
+
+            const size_t outcomes = (m_code_size + 1) * (m_code_size + 1);
+            std::vector<size_t> partition(outcomes);
+            std::set<code_type> scored{};
+            // Scores one guess and tells whether there is time left for another.
+            auto consider = [&](const code_type& guess) {
+                scored.insert(guess);
+                std::fill(partition.begin(), partition.end(), 0);
+                const mask_type guess_mask = mask_of(guess);
+                for (size_t s{ 0 }; s < secrets.size(); ++s) {
+                    size_t in_place{ 0 };
+                    for (size_t i{ 0 }; i < m_code_size; ++i) {
+                        in_place += (guess[i] == secrets[s][i]) ? 1 : 0;
+                    }
+                    const size_t common = std::bitset<64>{ guess_mask & secret_masks[s] }.count();
+                    ++partition[in_place * (m_code_size + 1) + (common - in_place)];
+                }
+
+                size_t score{ 0 };
+                for (size_t count : partition) {
+                    score += count * count;
+                }
+                if (score < m_progress.best_score) {
+                    m_progress.best_score = score;
+                    best = guess;
+                }
+                return clock_type::now() < deadline;
+            };
+
+            bool in_time{ true };
+            for (size_t i{ 0 }; i < secrets.size() && in_time; ++i) {
+                in_time = consider(secrets[i]);
+                ++m_progress.consistent_scored;
+            }
+
+            // Depth-first over codes whose unplayed colors appear in increasing order, so
+            // every class of codes equal up to a permutation of unplayed colors is met once.
+            if (in_time) {
+                code_type code(m_code_size);
+                size_t visited{ 0 };
+                auto representatives = [&](auto& self, size_t position, mask_type used) -> bool {
+                    if (position == m_code_size) {
+                        if (++visited > m_options.max_representatives) {
+                            return false;
+                        }
+                        if (scored.count(code) == 0) {
+                            ++m_progress.representatives_scored;
+                            in_time = consider(code);
+                        }
+                        return in_time;
+                    }
+                    bool fresh_tried{ false };
+                    for (size_t color{ 0 }; color < m_code_set.size(); ++color) {
+                        const mask_type bit = mask_type{ 1 } << color;
+                        if ((used & bit) != 0) {
+                            continue;
+                        }
+                        if ((m_played & bit) == 0) {
+                            if (fresh_tried) {
+                                continue;
+                            }
+                            fresh_tried = true;
+                        }
+                        code[position] = color;
+                        if (!self(self, position + 1, used | bit)) {
+                            return false;
+                        }
+                    }
+                    return true;
+                };
+                m_progress.representatives_complete = representatives(representatives, 0, mask_type{ 0 }) && in_time;
+            }
+
+            for (size_t attempt{ 0 }; in_time && attempt < 4 * m_options.sampled_guesses
+                && m_progress.sampled_scored < m_options.sampled_guesses; ++attempt) {
+                code_type code = random_code();
+                canonicalize(code);
+                if (scored.count(code) == 0) {
+                    ++m_progress.sampled_scored;
+                    in_time = consider(code);
+                }
+            }
+        }
+
+        const clock_type::time_point end = clock_type::now();
+        m_progress.deadline_reached = end >= deadline;
+        m_progress.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+        if (m_progress_callback) {
+            m_progress_callback(m_progress);
+        }
+        return to_items(best);
+    }
+
+    template<typename Item>
+    void anytime_solver<Item>::add_feedback(const std::vector<Item>& guess, game_result result) {
+        if (guess.size() != m_code_size) {
+            throw incorrect_code_size_error{ guess.size(), m_code_size };
+        }
+
+        code_type indices{};
+        indices.reserve(guess.size());
+        for (const Item& value : guess) {
+            auto it = std::find(m_code_set.begin(), m_code_set.end(), value);
+            if (it == m_code_set.end()) {
+                throw value_not_in_code_set_error();
+            }
+            indices.push_back(static_cast<size_t>(it - m_code_set.begin()));
+        }
+
+        m_consistency.add_feedback(indices, result);
+        m_played |= mask_of(indices);
+    }
+
+    template<typename Item>
+    std::vector<Item> anytime_solver<Item>::to_items(const code_type& code) const {
+        std::vector<Item> items{};
+        items.reserve(code.size());
+        for (size_t index : code) {
+            items.push_back(m_code_set[index]);
+        }
+        return items;
+    }
+
+    template<typename Item>
+    typename anytime_solver<Item>::code_type anytime_solver<Item>::random_code() {
+        code_type colors(m_code_set.size());
+        for (size_t i{ 0 }; i < colors.size(); ++i) {
+            colors[i] = i;
+        }
+        for (size_t i{ 0 }; i < m_code_size; ++i) {
+            std::uniform_int_distribution<size_t> pick{ i, colors.size() - 1 };
+            std::swap(colors[i], colors[pick(m_generator)]);
+        }
+        colors.resize(m_code_size);
+        return colors;
+    }
+
+    // Renames the unplayed colors of the code to the lowest unplayed colors, in order of
+    // appearance, which gives the representative the depth-first enumeration visits.
+    template<typename Item>
+    void anytime_solver<Item>::canonicalize(code_type& code) const {
+        size_t next_fresh{ 0 };
+        for (size_t& color : code) {
+            if ((m_played >> color & 1) == 0) {
+                while ((m_played >> next_fresh & 1) != 0) {
+                    ++next_fresh;
+                }
+                color = next_fresh++;
+            }
+        }
+    }
+
+    template<typename Item>
+    typename anytime_solver<Item>::mask_type anytime_solver<Item>::mask_of(const code_type& code) {
+        mask_type mask{ 0 };
+        for (size_t color : code) {
+            mask |= mask_type{ 1 } << color;
+        }
+        return mask;
+    }
+
+}
@@ -1,7 +1,12 @@
 #pragma once
 
+#include "mastermind_difficulty_index.hpp"
+#include "mastermind_exceptions.hpp"
+#include "mastermind_utils.hpp"
 #include <algorithm>
+#include <memory>
 #include <random>
+#include <string>
 #include <vector>
 
 
@@ -10,21 +15,69 @@ namespace mastermind {
     template<typename Item>
     class basic_code_pattern_generator {
     public:
-        explicit basic_code_pattern_generator(const std::vector<Item>& code_set);
+        explicit basic_code_pattern_generator(const std::vector<Item>& code_set, code_rule rule = code_rule::DISTINCT_VALUES);
+        // Draws only secrets whose difficulty in the index lies in the band. The code set
+        // must be the one the index was built for, in the same order.
+        basic_code_pattern_generator(const std::vector<Item>& code_set, std::shared_ptr<const difficulty_index> index, difficulty_band band);
         std::vector<Item> operator()(size_t pattern_size);
     private:
         std::vector<Item> m_code_set;
+        code_rule m_rule;
+        std::shared_ptr<const difficulty_index> m_index{};
+        difficulty_band m_band{ 0, 0 };
         std::random_device rd{};
         std::mt19937 g{ rd() };
     };
 
     template<typename Item>
-    basic_code_pattern_generator<Item>::basic_code_pattern_generator(const std::vector<Item>& code_set)
-        : m_code_set{ code_set } {
+    basic_code_pattern_generator<Item>::basic_code_pattern_generator(const std::vector<Item>& code_set, code_rule rule)
+        : m_code_set{ code_set }, m_rule{ rule } {
+    };
+
+    template<typename Item>
+    basic_code_pattern_generator<Item>::basic_code_pattern_generator(const std::vector<Item>& code_set, std::shared_ptr<const difficulty_index> index, difficulty_band band)
+        : m_code_set{ code_set }, m_rule{ code_rule::DISTINCT_VALUES }, m_index{ std::move(index) }, m_band{ band } {
+        if (!m_index) {
+            throw difficulty_index_error{ "no difficulty index given" };
+        }
+        if (m_code_set.size() != m_index->get_code_space().get_code_set_size()) {
+            throw difficulty_index_error{ "built for " + std::to_string(m_index->get_code_space().get_code_set_size())
+                + " values but the code set has " + std::to_string(m_code_set.size()) };
+        }
+        if (m_index->count(m_band) == 0) {
+            throw empty_difficulty_band_error{ m_band.min_difficulty, m_band.max_difficulty };
+        }
     };
 
     template<typename Item>
     std::vector<Item> basic_code_pattern_generator<Item>::operator()(size_t pattern_size) {
+        if (m_index) {
+            const code_space& space = m_index->get_code_space();
+            if (pattern_size != space.get_code_size()) {
+                throw incorrect_code_size_error{ pattern_size, space.get_code_size() };
+            }
+            std::vector<size_t> code = space.unrank(m_index->sample(m_band, g));
+            std::vector<Item> pattern{};
+            pattern.reserve(pattern_size);
+            for (size_t index : code) {
+                pattern.push_back(m_code_set[index]);
+            }
+            return pattern;
+        }
+
+        if (m_rule == code_rule::REPEATED_VALUES) {
+            if (m_code_set.empty() && pattern_size > 0) {
+                throw code_set_too_small_error{ pattern_size, 0 };
+            }
+            std::uniform_int_distribution<size_t> any_value{ 0, m_code_set.size() - 1 };
+            std::vector<Item> pattern{};
+            pattern.reserve(pattern_size);
+            for (size_t i{ 0 }; i < pattern_size; ++i) {
+                pattern.push_back(m_code_set[any_value(g)]);
+            }
+            return pattern;
+        }
+
         std::shuffle(m_code_set.begin(), m_code_set.end(), g);
         return { m_code_set.begin(), m_code_set.begin() + pattern_size };
     }
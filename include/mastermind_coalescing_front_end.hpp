@@ -0,0 +1,237 @@
+#pragma once
+
+#include "mastermind_engine.hpp"
+#include "mastermind_utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+
+namespace mastermind {
+
+    struct coalescing_options {
+        size_t max_batch{ 256 };
+        std::chrono::microseconds window{ 50 };
+    };
+
+    // Front-end letting many threads submit guesses for engines without locking them.
+    // Submissions go through a lock-free multi-producer single-consumer queue to one
+    // dispatcher thread, which waits until max_batch guesses are pending or window has
+    // passed since the first of them, scores the whole batch with
+    // mastermind_engine::check_solutions and then completes every caller. An engine must
+    // only be used through the front-end while it has guesses in flight; guesses for the
+    // same engine from one thread are applied in submission order. Exceptions thrown by
+    // callbacks are counted in get_callback_errors and otherwise ignored.
+    template<typename Item>
+    class coalescing_front_end {
+    public:
+        typedef mastermind_engine<Item> engine_type;
+        typedef std::function<void(std::optional<game_result>, std::exception_ptr)> callback_type;
+
+        explicit coalescing_front_end(coalescing_options options = {});
+        coalescing_front_end(const coalescing_front_end&) = delete;
+        coalescing_front_end& operator=(const coalescing_front_end&) = delete;
+        ~coalescing_front_end();
+
+        std::future<std::optional<game_result>> check_solution(engine_type& engine, std::vector<Item> solution);
+        void check_solution(engine_type& engine, std::vector<Item> solution, callback_type callback);
+
+        std::uint64_t get_batches() const { return m_batches.load(std::memory_order_relaxed); }
+        std::uint64_t get_requests() const { return m_requests.load(std::memory_order_relaxed); }
+        std::uint64_t get_callback_errors() const { return m_callback_errors.load(std::memory_order_relaxed); }
+
+    private:
+        struct request {
+            std::atomic<request*> next{ nullptr };
+            engine_type* engine{ nullptr };
+            std::vector<Item> solution{};
+            std::promise<std::optional<game_result>> promise{};
+            callback_type callback{};
+        };
+
+        coalescing_options m_options;
+        request m_stub{};
+        std::atomic<request*> m_head{ &m_stub };
+        request* m_tail{ &m_stub };
+        std::atomic<bool> m_stopping{ false };
+        std::atomic<size_t> m_pending{ 0 };
+        std::atomic<bool> m_sleeping{ false };
+        std::atomic<std::uint64_t> m_batches{ 0 };
+        std::atomic<std::uint64_t> m_requests{ 0 };
+        std::atomic<std::uint64_t> m_callback_errors{ 0 };
+        std::mutex m_mutex{};
+        std::condition_variable m_wake{};
+        std::thread m_dispatcher{};
+
+        void link(request* r);
+        void push(request* r);
+        request* pop();
+        void dispatch();
+        void complete(std::vector<std::unique_ptr<request>>& batch);
+    };
+
+    template<typename Item>
+    coalescing_front_end<Item>::coalescing_front_end(coalescing_options options)
+        : m_options{ options } {
+        m_options.max_batch = std::max<size_t>(m_options.max_batch, 1);
+        m_dispatcher = std::thread{ [this]() { dispatch(); } };
+    }
+
+    template<typename Item>
+    coalescing_front_end<Item>::~coalescing_front_end() {
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            m_stopping = true;
+        }
+        m_wake.notify_one();
+        m_dispatcher.join();
+    }
+
+    template<typename Item>
+    std::future<std::optional<game_result>> coalescing_front_end<Item>::check_solution(engine_type& engine, std::vector<Item> solution) {
+        auto r = std::make_unique<request>();
+        r->engine = &engine;
+        r->solution = std::move(solution);
+        std::future<std::optional<game_result>> result = r->promise.get_future();
+        push(r.release());
+        return result;
+    }
+
+    template<typename Item>
+    void coalescing_front_end<Item>::check_solution(engine_type& engine, std::vector<Item> solution, callback_type callback) {
+        auto r = std::make_unique<request>();
+        r->engine = &engine;
+        r->solution = std::move(solution);
+        r->callback = std::move(callback);
+        push(r.release());
+    }
+
+    // Intrusive MPSC queue: producers swing m_head with one exchange and then link the
+    // previous node; the consumer follows next pointers from m_tail, keeping a stub
+    // node in the list so that it never becomes empty.
+    template<typename Item>
+    void coalescing_front_end<Item>::link(request* r) {
+        r->next.store(nullptr, std::memory_order_relaxed);
+        request* previous = m_head.exchange(r, std::memory_order_acq_rel);
+        previous->next.store(r, std::memory_order_release);
+    }
+
+    template<typename Item>
+    void coalescing_front_end<Item>::push(request* r) {
+        link(r);
+        m_pending.fetch_add(1);
+        if (m_sleeping.load()) {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            m_wake.notify_one();
+        }
+    }
+
+    // Returns nullptr when the queue is empty or a producer is between its exchange
+    // and its link; the caller simply retries later.
+    template<typename Item>
+    typename coalescing_front_end<Item>::request* coalescing_front_end<Item>::pop() {
+        request* tail = m_tail;
+        request* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &m_stub) {
+            if (next == nullptr) {
+                return nullptr;
+            }
+            m_tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next != nullptr) {
+            m_tail = next;
+            return tail;
+        }
+        if (tail != m_head.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+
+        link(&m_stub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next != nullptr) {
+            m_tail = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+    template<typename Item>
+    void coalescing_front_end<Item>::dispatch() {
+        std::vector<std::unique_ptr<request>> batch{};
+        batch.reserve(m_options.max_batch);
+
+        while (true) {
+            request* first = pop();
+            if (first == nullptr) {
+                if (m_stopping.load() && m_pending.load() == 0) {
+                    return;
+                }
+                std::unique_lock<std::mutex> lock{ m_mutex };
+                m_sleeping.store(true);
+                m_wake.wait_for(lock, std::chrono::milliseconds{ 10 }, [this]() { return m_pending.load() > 0 || m_stopping.load(); });
+                m_sleeping.store(false);
+                continue;
+            }
+
+            batch.emplace_back(first);
+            const auto deadline = std::chrono::steady_clock::now() + m_options.window;
+            while (batch.size() < m_options.max_batch) {
+                if (request* r = pop()) {
+                    batch.emplace_back(r);
+                }
+                else if (std::chrono::steady_clock::now() >= deadline || m_stopping.load(std::memory_order_acquire)) {
+                    break;
+                }
+                else {
+                    std::this_thread::yield();
+                }
+            }
+
+            complete(batch);
+            batch.clear();
+        }
+    }
+
+    template<typename Item>
+    void coalescing_front_end<Item>::complete(std::vector<std::unique_ptr<request>>& batch) {
+        std::vector<typename engine_type::check_solution_request> checks{};
+        checks.reserve(batch.size());
+        for (const auto& r : batch) {
+            checks.push_back({ r->engine, &r->solution, std::nullopt, nullptr });
+        }
+        engine_type::check_solutions(checks.data(), checks.size());
+
+        m_pending.fetch_sub(batch.size());
+        m_batches.fetch_add(1, std::memory_order_relaxed);
+        m_requests.fetch_add(batch.size(), std::memory_order_relaxed);
+        for (size_t i{ 0 }; i < batch.size(); ++i) {
+            request& r = *batch[i];
+            if (r.callback) {
+                try {
+                    r.callback(checks[i].result, checks[i].error);
+                }
+                catch (...) {
+                    m_callback_errors.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            else if (checks[i].error) {
+                r.promise.set_exception(checks[i].error);
+            }
+            else {
+                r.promise.set_value(checks[i].result);
+            }
+        }
+    }
+
+}
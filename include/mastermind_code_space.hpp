@@ -0,0 +1,169 @@
+#pragma once
+
+#include "mastermind_exceptions.hpp"
+#include "mastermind_utils.hpp"
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+namespace mastermind {
+
+    // Lexicographic ranking of the codes of code_size distinct values taken from
+    // code_set_size values. Codes are vectors of indices into the code set.
+    class code_space {
+    public:
+        typedef std::uint64_t rank_type;
+        typedef std::uint64_t mask_type;
+        static constexpr size_t max_code_set_size{ 64 };
+
+        code_space(size_t code_set_size, size_t code_size);
+
+        rank_type size() const { return m_size; }
+        size_t get_code_set_size() const { return m_code_set_size; }
+        size_t get_code_size() const { return m_code_size; }
+
+        rank_type rank(const std::vector<size_t>& code) const;
+        std::vector<size_t> unrank(rank_type r) const;
+        void unrank(rank_type r, size_t* code) const;
+
+    private:
+        size_t m_code_set_size;
+        size_t m_code_size;
+        rank_type m_size{ 1 };
+        std::vector<rank_type> m_weights{};
+    };
+
+    inline code_space::code_space(size_t code_set_size, size_t code_size)
+        : m_code_set_size{ code_set_size }, m_code_size{ code_size } {
+        if (m_code_set_size > max_code_set_size) {
+            throw code_set_too_large_error{ m_code_set_size, max_code_set_size };
+        }
+        if (m_code_size > m_code_set_size) {
+            throw code_set_too_small_error{ m_code_size, m_code_set_size };
+        }
+
+        m_weights.assign(m_code_size, 1);
+        for (size_t i{ m_code_size }; i-- > 0;) {
+            rank_type factor = m_code_set_size - i;
+            if (m_size > UINT64_MAX / factor) {
+                throw code_space_too_large_error{ m_code_set_size, m_code_size };
+            }
+            m_weights[i] = m_size;
+            m_size *= factor;
+        }
+    }
+
+    inline code_space::rank_type code_space::rank(const std::vector<size_t>& code) const {
+        rank_type r{ 0 };
+        mask_type used{ 0 };
+        for (size_t i{ 0 }; i < m_code_size; ++i) {
+            mask_type below = (mask_type{ 1 } << code[i]) - 1;
+            r += (code[i] - std::bitset<64>{ used & below }.count()) * m_weights[i];
+            used |= mask_type{ 1 } << code[i];
+        }
+        return r;
+    }
+
+    inline std::vector<size_t> code_space::unrank(rank_type r) const {
+        std::vector<size_t> code(m_code_size);
+        unrank(r, code.data());
+        return code;
+    }
+
+    inline void code_space::unrank(rank_type r, size_t* code) const {
+        mask_type used{ 0 };
+        for (size_t i{ 0 }; i < m_code_size; ++i) {
+            rank_type skip = r / m_weights[i];
+            r %= m_weights[i];
+
+            size_t color{ 0 };
+            for (; (used >> color & 1) != 0 || skip > 0; ++color) {
+                if ((used >> color & 1) == 0) {
+                    --skip;
+                }
+            }
+            code[i] = color;
+            used |= mask_type{ 1 } << color;
+        }
+    }
+
+    // Precomputed game_result of every guess against every secret of a small code space,
+    // encoded in one byte per pair as pegs_in_right_place * (code_size + 1) + pegs_in_right_color.
+    class feedback_table {
+    public:
+        typedef code_space::rank_type rank_type;
+        typedef std::uint8_t feedback_type;
+        static constexpr rank_type max_codes{ 8192 };
+
+        explicit feedback_table(const code_space& space, size_t threads = std::thread::hardware_concurrency());
+
+        feedback_type operator()(rank_type guess, rank_type secret) const { return m_table[guess * m_codes + secret]; }
+        const feedback_type* row(rank_type guess) const { return m_table.data() + guess * m_codes; }
+        size_t get_feedback_count() const { return (m_space.get_code_size() + 1) * (m_space.get_code_size() + 1); }
+        const code_space& get_code_space() const { return m_space; }
+
+        static feedback_type encode(game_result result, size_t code_size);
+        static game_result decode(feedback_type feedback, size_t code_size);
+
+    private:
+        code_space m_space;
+        rank_type m_codes;
+        std::vector<feedback_type> m_table;
+    };
+
+    inline feedback_table::feedback_table(const code_space& space, size_t threads)
+        : m_space{ space }, m_codes{ space.size() } {
+        if (m_codes > max_codes) {
+            throw code_space_too_large_error{ space.get_code_set_size(), space.get_code_size() };
+        }
+
+        const size_t code_size = m_space.get_code_size();
+        std::vector<size_t> codes(m_codes * code_size);
+        std::vector<code_space::mask_type> masks(m_codes, 0);
+        for (rank_type r{ 0 }; r < m_codes; ++r) {
+            m_space.unrank(r, &codes[r * code_size]);
+            for (size_t i{ 0 }; i < code_size; ++i) {
+                masks[r] |= code_space::mask_type{ 1 } << codes[r * code_size + i];
+            }
+        }
+
+        m_table.resize(m_codes * m_codes);
+        auto fill_rows = [&](rank_type first, rank_type last) {
+            for (rank_type g{ first }; g < last; ++g) {
+                const size_t* guess = &codes[g * code_size];
+                for (rank_type s{ 0 }; s < m_codes; ++s) {
+                    const size_t* secret = &codes[s * code_size];
+                    size_t in_place{ 0 };
+                    for (size_t i{ 0 }; i < code_size; ++i) {
+                        in_place += (guess[i] == secret[i]) ? 1 : 0;
+                    }
+                    size_t common = std::bitset<64>{ masks[g] & masks[s] }.count();
+                    m_table[g * m_codes + s] = static_cast<feedback_type>(in_place * (code_size + 1) + (common - in_place));
+                }
+            }
+        };
+
+        threads = std::max<size_t>(1, std::min<size_t>(threads, m_codes));
+        std::vector<std::thread> workers{};
+        rank_type chunk = (m_codes + threads - 1) / threads;
+        for (rank_type first{ 0 }; first < m_codes; first += chunk) {
+            workers.emplace_back(fill_rows, first, std::min(first + chunk, m_codes));
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    inline feedback_table::feedback_type feedback_table::encode(game_result result, size_t code_size) {
+        return static_cast<feedback_type>(result.pegs_in_right_place * (code_size + 1) + result.pegs_in_right_color);
+    }
+
+    inline game_result feedback_table::decode(feedback_type feedback, size_t code_size) {
+        size_t in_place = feedback / (code_size + 1);
+        return game_result{ in_place == code_size, in_place, feedback % (code_size + 1) };
+    }
+
+}
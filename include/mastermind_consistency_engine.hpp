@@ -0,0 +1,355 @@
+#pragma once
+
+#include "mastermind_exceptions.hpp"
+#include "mastermind_perf_counters.hpp"
+#include "mastermind_utils.hpp"
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+
+namespace mastermind {
+
+    // Finds codes consistent with all feedback without enumerating the code space.
+    // Every game_result becomes a constraint on the number of exact position hits and
+    // on the number of shared colors. Per-position color domains are bitsets pruned
+    // by those constraints, and consistent codes are built by backtracking search
+    // with forward checking.
+    template<typename Item>
+    class consistency_engine {
+    public:
+        typedef Item value_type;
+        typedef std::uint64_t domain_type;
+        static constexpr size_t max_code_set_size{ 64 };
+        static constexpr size_t stop_check_interval{ 256 };
+
+        consistency_engine(const std::vector<Item>& code_set, game_start_params start_params);
+
+        void add_feedback(const std::vector<Item>& guess, game_result result);
+        bool is_consistent(const std::vector<Item>& code) const;
+
+        std::optional<std::vector<Item>> find_consistent();
+        template<typename URBG>
+        std::optional<std::vector<Item>> find_consistent(URBG& g);
+        template<typename Visitor>
+        void for_each_consistent(Visitor visitor);
+        template<typename URBG, typename Visitor>
+        void for_each_consistent(URBG& g, Visitor visitor);
+        // Same, but the search is also truncated once stop() returns true; stop is
+        // called every stop_check_interval nodes.
+        template<typename URBG, typename Visitor, typename Stop>
+        void for_each_consistent(URBG& g, Visitor visitor, Stop stop);
+
+        domain_type get_domain(size_t position) const { return m_domains[position]; }
+        size_t get_feedback_count() const { return m_constraints.size(); }
+        size_t get_nodes_visited() const { return m_nodes_visited; }
+        bool is_search_truncated() const { return m_search_truncated; }
+        void set_node_limit(size_t node_limit) { m_node_limit = node_limit; }
+
+    private:
+        struct constraint {
+            std::vector<size_t> guess;
+            domain_type colors;
+            size_t in_place;
+            size_t common;
+        };
+
+        struct search_state {
+            std::vector<size_t> code;
+            std::vector<size_t> in_place_hits;
+            std::vector<size_t> common_hits;
+            domain_type used;
+        };
+
+        static constexpr size_t npos{ SIZE_MAX };
+
+        std::vector<Item> m_code_set;
+        size_t m_code_size;
+        domain_type m_all_colors;
+        std::vector<domain_type> m_domains;
+        std::vector<constraint> m_constraints{};
+        size_t m_node_limit{ SIZE_MAX };
+        size_t m_nodes_visited{ 0 };
+        bool m_search_truncated{ false };
+
+        static domain_type bit(size_t color) { return domain_type{ 1 } << color; }
+        static size_t count_bits(domain_type d) { return std::bitset<64>{ d }.count(); }
+
+        size_t index_of(const Item& value) const;
+        std::vector<Item> to_items(const std::vector<size_t>& code) const;
+        domain_type candidates(size_t position, const search_state& state) const;
+        bool is_feasible(size_t depth, const search_state& state) const;
+        void assign(size_t position, size_t color, search_state& state) const;
+        void unassign(size_t position, search_state& state) const;
+        template<typename Order, typename Visitor, typename Stop>
+        bool search(size_t depth, search_state& state, Order& order, Visitor& visitor, Stop& stop);
+        template<typename Order, typename Visitor, typename Stop>
+        void run_search(Order order, Visitor visitor, Stop stop);
+    };
+
+    template<typename Item>
+    consistency_engine<Item>::consistency_engine(const std::vector<Item>& code_set, game_start_params start_params)
+        : m_code_set{ code_set }, m_code_size{ start_params.code_size } {
+        if (m_code_set.size() > max_code_set_size) {
+            throw code_set_too_large_error{ m_code_set.size(), max_code_set_size };
+        }
+        if (m_code_size > m_code_set.size()) {
+            throw code_set_too_small_error{ m_code_size, m_code_set.size() };
+        }
+        if (!are_all_values_different(m_code_set)) {
+            throw indistinct_values_error();
+        }
+
+        m_all_colors = (m_code_set.size() == 64) ? ~domain_type{ 0 } : bit(m_code_set.size()) - 1;
+        m_domains.assign(m_code_size, m_all_colors);
+    }
+
+    template<typename Item>
+    void consistency_engine<Item>::add_feedback(const std::vector<Item>& guess, game_result result) {
+        if (guess.size() != m_code_size) {
+            throw incorrect_code_size_error{ guess.size(), m_code_size };
+        }
+
+        constraint c{ {}, 0, result.pegs_in_right_place, result.pegs_in_right_place + result.pegs_in_right_color };
+        c.guess.reserve(m_code_size);
+        for (const Item& value : guess) {
+            size_t color = index_of(value);
+            if (color == npos) {
+                throw value_not_in_code_set_error();
+            }
+            c.guess.push_back(color);
+            c.colors |= bit(color);
+        }
+
+        for (size_t i{ 0 }; i < m_code_size; ++i) {
+            if (c.in_place == 0) {
+                m_domains[i] &= ~bit(c.guess[i]);
+            }
+            if (c.in_place == m_code_size) {
+                m_domains[i] &= bit(c.guess[i]);
+            }
+            if (c.common == 0) {
+                m_domains[i] &= ~c.colors;
+            }
+            if (c.common == m_code_size) {
+                m_domains[i] &= c.colors;
+            }
+        }
+
+        m_constraints.push_back(std::move(c));
+    }
+
+    template<typename Item>
+    bool consistency_engine<Item>::is_consistent(const std::vector<Item>& code) const {
+        if (code.size() != m_code_size) {
+            return false;
+        }
+
+        std::vector<size_t> colors(m_code_size);
+        domain_type used{ 0 };
+        for (size_t i{ 0 }; i < m_code_size; ++i) {
+            colors[i] = index_of(code[i]);
+            if (colors[i] == npos || (used & bit(colors[i])) != 0) {
+                return false;
+            }
+            used |= bit(colors[i]);
+        }
+
+        for (const constraint& c : m_constraints) {
+            size_t in_place{ 0 };
+            for (size_t i{ 0 }; i < m_code_size; ++i) {
+                in_place += (c.guess[i] == colors[i]) ? 1 : 0;
+            }
+            if (in_place != c.in_place || count_bits(used & c.colors) != c.common) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename Item>
+    std::optional<std::vector<Item>> consistency_engine<Item>::find_consistent() {
+        std::optional<std::vector<Item>> found{};
+        for_each_consistent([&found](const std::vector<Item>& code) {
+            found = code;
+            return false;
+        });
+        return found;
+    }
+
+    template<typename Item>
+    template<typename URBG>
+    std::optional<std::vector<Item>> consistency_engine<Item>::find_consistent(URBG& g) {
+        std::optional<std::vector<Item>> found{};
+        run_search([&g](size_t* first, size_t* last) { std::shuffle(first, last, g); },
+            [&found](const std::vector<Item>& code) {
+                found = code;
+                return false;
+            }, []() { return false; });
+        return found;
+    }
+
+    template<typename Item>
+    template<typename Visitor>
+    void consistency_engine<Item>::for_each_consistent(Visitor visitor) {
+        run_search([](size_t*, size_t*) {}, visitor, []() { return false; });
+    }
+
+    template<typename Item>
+    template<typename URBG, typename Visitor>
+    void consistency_engine<Item>::for_each_consistent(URBG& g, Visitor visitor) {
+        run_search([&g](size_t* first, size_t* last) { std::shuffle(first, last, g); }, visitor, []() { return false; });
+    }
+
+    template<typename Item>
+    template<typename URBG, typename Visitor, typename Stop>
+    void consistency_engine<Item>::for_each_consistent(URBG& g, Visitor visitor, Stop stop) {
+        run_search([&g](size_t* first, size_t* last) { std::shuffle(first, last, g); }, visitor, stop);
+    }
+
+    template<typename Item>
+    size_t consistency_engine<Item>::index_of(const Item& value) const {
+        auto it = std::find(m_code_set.begin(), m_code_set.end(), value);
+        return (it == m_code_set.end()) ? npos : static_cast<size_t>(it - m_code_set.begin());
+    }
+
+    template<typename Item>
+    std::vector<Item> consistency_engine<Item>::to_items(const std::vector<size_t>& code) const {
+        std::vector<Item> items{};
+        items.reserve(code.size());
+        for (size_t color : code) {
+            items.push_back(m_code_set[color]);
+        }
+        return items;
+    }
+
+    template<typename Item>
+    typename consistency_engine<Item>::domain_type consistency_engine<Item>::candidates(size_t position, const search_state& state) const {
+        domain_type d = m_domains[position] & ~state.used;
+        size_t remaining = m_code_size - position;
+
+        for (size_t j{ 0 }; j < m_constraints.size() && d != 0; ++j) {
+            const constraint& c = m_constraints[j];
+            size_t missing_in_place = c.in_place - state.in_place_hits[j];
+            size_t missing_common = c.common - state.common_hits[j];
+
+            if (missing_in_place == 0) {
+                d &= ~bit(c.guess[position]);
+            }
+            else if (missing_in_place == remaining) {
+                d &= bit(c.guess[position]);
+            }
+
+            if (missing_common == 0) {
+                d &= ~c.colors;
+            }
+            else if (missing_common == remaining) {
+                d &= c.colors;
+            }
+        }
+        return d;
+    }
+
+    template<typename Item>
+    bool consistency_engine<Item>::is_feasible(size_t depth, const search_state& state) const {
+        size_t remaining = m_code_size - depth;
+
+        for (size_t j{ 0 }; j < m_constraints.size(); ++j) {
+            const constraint& c = m_constraints[j];
+            if (state.in_place_hits[j] > c.in_place || state.common_hits[j] > c.common) {
+                return false;
+            }
+
+            size_t possible_in_place{ 0 };
+            for (size_t i{ depth }; i < m_code_size; ++i) {
+                if ((m_domains[i] & ~state.used & bit(c.guess[i])) != 0) {
+                    ++possible_in_place;
+                }
+            }
+            if (state.in_place_hits[j] + possible_in_place < c.in_place) {
+                return false;
+            }
+
+            size_t missing_common = c.common - state.common_hits[j];
+            if (count_bits(c.colors & ~state.used) < missing_common || missing_common > remaining) {
+                return false;
+            }
+            if (count_bits(m_all_colors & ~c.colors & ~state.used) < remaining - missing_common) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename Item>
+    void consistency_engine<Item>::assign(size_t position, size_t color, search_state& state) const {
+        state.code[position] = color;
+        state.used |= bit(color);
+        for (size_t j{ 0 }; j < m_constraints.size(); ++j) {
+            state.in_place_hits[j] += (m_constraints[j].guess[position] == color) ? 1 : 0;
+            state.common_hits[j] += ((m_constraints[j].colors & bit(color)) != 0) ? 1 : 0;
+        }
+    }
+
+    template<typename Item>
+    void consistency_engine<Item>::unassign(size_t position, search_state& state) const {
+        size_t color = state.code[position];
+        state.used &= ~bit(color);
+        for (size_t j{ 0 }; j < m_constraints.size(); ++j) {
+            state.in_place_hits[j] -= (m_constraints[j].guess[position] == color) ? 1 : 0;
+            state.common_hits[j] -= ((m_constraints[j].colors & bit(color)) != 0) ? 1 : 0;
+        }
+    }
+
+    template<typename Item>
+    template<typename Order, typename Visitor, typename Stop>
+    bool consistency_engine<Item>::search(size_t depth, search_state& state, Order& order, Visitor& visitor, Stop& stop) {
+        if (m_nodes_visited >= m_node_limit
+            || (m_nodes_visited != 0 && m_nodes_visited % stop_check_interval == 0 && stop())) {
+            m_search_truncated = true;
+            return false;
+        }
+        ++m_nodes_visited;
+
+        if (depth == m_code_size) {
+            return visitor(to_items(state.code));
+        }
+
+        size_t colors[max_code_set_size];
+        size_t count{ 0 };
+        domain_type d = candidates(depth, state);
+        for (size_t color{ 0 }; d != 0; ++color, d >>= 1) {
+            if ((d & 1) != 0) {
+                colors[count++] = color;
+            }
+        }
+        order(colors, colors + count);
+
+        for (size_t k{ 0 }; k < count; ++k) {
+            assign(depth, colors[k], state);
+            bool proceed = !is_feasible(depth + 1, state) || search(depth + 1, state, order, visitor, stop);
+            unassign(depth, state);
+            if (!proceed) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename Item>
+    template<typename Order, typename Visitor, typename Stop>
+    void consistency_engine<Item>::run_search(Order order, Visitor visitor, Stop stop) {
+        MASTERMIND_PERF_SCOPE("consistency_engine.search");
+        m_nodes_visited = 0;
+        m_search_truncated = false;
+
+        search_state state{ std::vector<size_t>(m_code_size), std::vector<size_t>(m_constraints.size(), 0),
+            std::vector<size_t>(m_constraints.size(), 0), 0 };
+        if (is_feasible(0, state)) {
+            search(0, state, order, visitor, stop);
+        }
+    }
+
+}
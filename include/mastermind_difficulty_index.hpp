@@ -0,0 +1,298 @@
+#pragma once
+
+#include "mastermind_code_space.hpp"
+#include "mastermind_exceptions.hpp"
+#include "mastermind_file_utils.hpp"
+#include "mastermind_perf_counters.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace mastermind {
+
+    struct difficulty_band {
+        std::uint8_t min_difficulty;
+        std::uint8_t max_difficulty;
+    };
+
+    // Number of guesses the reference strategy needs for every secret of a code space,
+    // indexed by code rank. The reference strategy always plays the lowest ranked code
+    // still consistent with the feedback, so secrets following the same feedback share
+    // their guesses and the whole space is solved as one tree of partitions.
+    //
+    // Ranks are also kept ordered by difficulty, which makes every band a contiguous
+    // range and lets sample() draw a secret of a band in constant time.
+    class difficulty_index {
+    public:
+        typedef code_space::rank_type rank_type;
+        static constexpr rank_type max_codes{ rank_type{ 1 } << 32 };
+
+        difficulty_index(const code_space& space, std::vector<std::uint8_t> difficulties);
+
+        static difficulty_index build(const code_space& space, size_t threads = std::thread::hardware_concurrency());
+        static difficulty_index load(const std::string& path);
+        void save(const std::string& path) const;
+
+        const code_space& get_code_space() const { return m_space; }
+        std::uint8_t get_difficulty(rank_type rank) const { return m_difficulties[rank]; }
+        std::uint8_t get_max_difficulty() const { return static_cast<std::uint8_t>(m_offsets.size() - 2); }
+        rank_type count(difficulty_band band) const;
+
+        template<typename URBG>
+        rank_type sample(difficulty_band band, URBG& g) const;
+
+    private:
+        code_space m_space;
+        std::vector<std::uint8_t> m_difficulties;
+        std::vector<std::uint32_t> m_order{};
+        std::vector<rank_type> m_offsets{};
+
+        std::pair<rank_type, rank_type> range(difficulty_band band) const;
+    };
+
+    constexpr char difficulty_index_magic[8]{ 'M', 'M', 'D', 'I', 'F', 'I', 'D', 'X' };
+    constexpr std::uint32_t difficulty_index_version{ 1 };
+
+    inline std::uint64_t difficulty_index_checksum(const char* data, size_t size) {
+        std::uint64_t hash{ 14695981039346656037ULL };
+        for (size_t i{ 0 }; i < size; ++i) {
+            hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    inline difficulty_index::difficulty_index(const code_space& space, std::vector<std::uint8_t> difficulties)
+        : m_space{ space }, m_difficulties{ std::move(difficulties) } {
+        if (m_space.size() > max_codes) {
+            throw code_space_too_large_error{ m_space.get_code_set_size(), m_space.get_code_size() };
+        }
+        if (m_difficulties.size() != m_space.size()) {
+            throw difficulty_index_error{ std::to_string(m_difficulties.size()) + " difficulties for " + std::to_string(m_space.size()) + " codes" };
+        }
+
+        const std::uint8_t max_difficulty = m_difficulties.empty() ? 0 : *std::max_element(m_difficulties.begin(), m_difficulties.end());
+        m_offsets.assign(static_cast<size_t>(max_difficulty) + 2, 0);
+        for (std::uint8_t difficulty : m_difficulties) {
+            ++m_offsets[difficulty + 1];
+        }
+        for (size_t d{ 1 }; d < m_offsets.size(); ++d) {
+            m_offsets[d] += m_offsets[d - 1];
+        }
+
+        std::vector<rank_type> next(m_offsets.begin(), m_offsets.end() - 1);
+        m_order.resize(m_difficulties.size());
+        for (rank_type r{ 0 }; r < m_difficulties.size(); ++r) {
+            m_order[next[m_difficulties[r]]++] = static_cast<std::uint32_t>(r);
+        }
+    }
+
+    inline difficulty_index difficulty_index::build(const code_space& space, size_t threads) {
+        MASTERMIND_PERF_SCOPE("difficulty_index.build");
+        const rank_type codes = space.size();
+        if (codes > max_codes) {
+            throw code_space_too_large_error{ space.get_code_set_size(), space.get_code_size() };
+        }
+        const size_t code_size = space.get_code_size();
+        const size_t feedbacks = (code_size + 1) * (code_size + 1);
+        threads = std::max<size_t>(1, std::min<rank_type>(threads, std::max<rank_type>(codes, 1)));
+
+        std::vector<std::uint8_t> colors(codes * code_size);
+        std::vector<code_space::mask_type> masks(codes, 0);
+        auto run = [threads](rank_type count, auto work) {
+            std::vector<std::thread> workers{};
+            rank_type chunk = (count + threads - 1) / threads;
+            for (rank_type first{ 0 }; first < count; first += chunk) {
+                workers.emplace_back(work, first, std::min(first + chunk, count));
+            }
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+        };
+        run(codes, [&](rank_type first, rank_type last) {
+            std::vector<size_t> code(code_size);
+            for (rank_type r{ first }; r < last; ++r) {
+                space.unrank(r, code.data());
+                for (size_t i{ 0 }; i < code_size; ++i) {
+                    colors[r * code_size + i] = static_cast<std::uint8_t>(code[i]);
+                    masks[r] |= code_space::mask_type{ 1 } << code[i];
+                }
+            }
+        });
+
+        // A partition is a range of work holding, in rank order, the secrets that gave
+        // the same feedback to the first depth guesses. Its lowest rank is the next guess
+        // and the rest are split by their feedback to it with a stable counting sort.
+        struct partition {
+            rank_type first;
+            rank_type last;
+            std::uint8_t depth;
+        };
+        std::vector<std::uint32_t> work(codes);
+        std::vector<std::uint32_t> scratch(codes);
+        std::vector<std::uint16_t> feedback(codes);
+        std::vector<std::uint8_t> difficulties(codes, 0);
+        for (rank_type r{ 0 }; r < codes; ++r) {
+            work[r] = static_cast<std::uint32_t>(r);
+        }
+
+        auto split = [&](const partition& p, std::vector<partition>& children) {
+            const rank_type guess = work[p.first];
+            difficulties[guess] = static_cast<std::uint8_t>(std::min<size_t>(p.depth + 1, UINT8_MAX));
+
+            std::vector<rank_type> offsets(feedbacks + 1, 0);
+            const std::uint8_t* guess_colors = &colors[guess * code_size];
+            for (rank_type i{ p.first + 1 }; i < p.last; ++i) {
+                const std::uint8_t* secret_colors = &colors[work[i] * code_size];
+                size_t in_place{ 0 };
+                for (size_t k{ 0 }; k < code_size; ++k) {
+                    in_place += (guess_colors[k] == secret_colors[k]) ? 1 : 0;
+                }
+                const size_t common = std::bitset<64>{ masks[guess] & masks[work[i]] }.count();
+                feedback[i] = static_cast<std::uint16_t>(in_place * (code_size + 1) + (common - in_place));
+                ++offsets[feedback[i] + 1];
+            }
+            for (size_t f{ 1 }; f <= feedbacks; ++f) {
+                offsets[f] += offsets[f - 1];
+            }
+
+            const rank_type base = p.first + 1;
+            std::vector<rank_type> next(offsets.begin(), offsets.end() - 1);
+            for (rank_type i{ base }; i < p.last; ++i) {
+                scratch[base + next[feedback[i]]++] = work[i];
+            }
+            std::copy(scratch.begin() + base, scratch.begin() + p.last, work.begin() + base);
+            for (size_t f{ 0 }; f < feedbacks; ++f) {
+                if (offsets[f + 1] > offsets[f]) {
+                    children.push_back({ base + offsets[f], base + offsets[f + 1], static_cast<std::uint8_t>(std::min<size_t>(p.depth + 1, UINT8_MAX)) });
+                }
+            }
+        };
+
+        // Partitions never overlap, so once the first levels produced enough of them the
+        // workers finish one partition each at a time without any locking.
+        std::vector<partition> pending{};
+        if (codes > 0) {
+            pending.push_back({ 0, codes, 0 });
+        }
+        while (!pending.empty() && pending.size() < 8 * threads) {
+            std::vector<partition> children{};
+            for (const partition& p : pending) {
+                split(p, children);
+            }
+            pending = std::move(children);
+        }
+
+        std::atomic<size_t> next_partition{ 0 };
+        run(threads, [&](rank_type, rank_type) {
+            std::vector<partition> stack{};
+            for (size_t i = next_partition++; i < pending.size(); i = next_partition++) {
+                stack.push_back(pending[i]);
+                while (!stack.empty()) {
+                    partition p = stack.back();
+                    stack.pop_back();
+                    split(p, stack);
+                }
+            }
+        });
+
+        return difficulty_index{ space, std::move(difficulties) };
+    }
+
+    // Little-endian header, one byte per code in rank order and a trailing checksum.
+    inline void difficulty_index::save(const std::string& path) const {
+        std::string bytes(difficulty_index_magic, sizeof(difficulty_index_magic));
+        auto put = [&bytes](std::uint64_t value, size_t width) {
+            for (size_t i{ 0 }; i < width; ++i) {
+                bytes.push_back(static_cast<char>(value >> (8 * i) & 0xFF));
+            }
+        };
+        put(difficulty_index_version, 4);
+        put(m_space.get_code_set_size(), 4);
+        put(m_space.get_code_size(), 4);
+        put(0, 4);
+        put(m_difficulties.size(), 8);
+        bytes.append(reinterpret_cast<const char*>(m_difficulties.data()), m_difficulties.size());
+        put(difficulty_index_checksum(bytes.data(), bytes.size()), 8);
+
+        try {
+            write_file_atomically(path, bytes.data(), bytes.size());
+        }
+        catch (const std::runtime_error& error) {
+            throw difficulty_index_error{ error.what() };
+        }
+    }
+
+    inline difficulty_index difficulty_index::load(const std::string& path) {
+        std::ifstream in{ path, std::ios::binary };
+        if (!in) {
+            throw difficulty_index_error{ "cannot open " + path };
+        }
+        const std::string bytes{ std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{} };
+
+        const size_t header_size{ sizeof(difficulty_index_magic) + 4 + 4 + 4 + 4 + 8 };
+        if (bytes.size() < header_size + 8 || std::memcmp(bytes.data(), difficulty_index_magic, sizeof(difficulty_index_magic)) != 0) {
+            throw difficulty_index_error{ path + " is not a difficulty index" };
+        }
+        size_t position{ sizeof(difficulty_index_magic) };
+        auto get = [&bytes, &position](size_t width) {
+            std::uint64_t value{ 0 };
+            for (size_t i{ 0 }; i < width; ++i) {
+                value |= std::uint64_t{ static_cast<unsigned char>(bytes[position++]) } << (8 * i);
+            }
+            return value;
+        };
+
+        const std::uint64_t version = get(4);
+        const size_t code_set_size = static_cast<size_t>(get(4));
+        const size_t code_size = static_cast<size_t>(get(4));
+        get(4);
+        const std::uint64_t codes = get(8);
+        if (version != difficulty_index_version) {
+            throw difficulty_index_error{ "unsupported version " + std::to_string(version) };
+        }
+        if (codes != bytes.size() - header_size - 8) {
+            throw difficulty_index_error{ "truncated index" };
+        }
+        position = bytes.size() - 8;
+        if (get(8) != difficulty_index_checksum(bytes.data(), bytes.size() - 8)) {
+            throw difficulty_index_error{ "checksum mismatch" };
+        }
+
+        const unsigned char* first = reinterpret_cast<const unsigned char*>(bytes.data()) + header_size;
+        return difficulty_index{ code_space{ code_set_size, code_size }, std::vector<std::uint8_t>(first, first + codes) };
+    }
+
+    inline std::pair<difficulty_index::rank_type, difficulty_index::rank_type> difficulty_index::range(difficulty_band band) const {
+        const size_t max_difficulty = get_max_difficulty();
+        if (band.min_difficulty > band.max_difficulty || band.min_difficulty > max_difficulty) {
+            return { 0, 0 };
+        }
+        const size_t last = std::min<size_t>(band.max_difficulty, max_difficulty);
+        return { m_offsets[band.min_difficulty], m_offsets[last + 1] };
+    }
+
+    inline difficulty_index::rank_type difficulty_index::count(difficulty_band band) const {
+        auto [first, last] = range(band);
+        return last - first;
+    }
+
+    template<typename URBG>
+    difficulty_index::rank_type difficulty_index::sample(difficulty_band band, URBG& g) const {
+        auto [first, last] = range(band);
+        if (first == last) {
+            throw empty_difficulty_band_error{ band.min_difficulty, band.max_difficulty };
+        }
+        return m_order[std::uniform_int_distribution<rank_type>{ first, last - 1 }(g)];
+    }
+
+}
@@ -2,7 +2,11 @@
 
 
 #include "mastermind_exceptions.hpp"
+#include "mastermind_metrics.hpp"
+#include "mastermind_perf_counters.hpp"
 #include "mastermind_utils.hpp"
+#include <chrono>
+#include <exception>
 #include <functional>
 #include <optional>
 #include <vector>
@@ -10,14 +14,30 @@
 
 namespace mastermind {
 
+    template <typename Item>
+    struct engine_state {
+        game_status status;
+        std::vector<Item> code_pattern;
+        size_t tries_left;
+        game_result current_result;
+        code_rule rule{ code_rule::DISTINCT_VALUES };
+    };
+
     template <typename Item>
     class mastermind_engine {
     public:
         typedef Item value_type;
         typedef std::function<std::vector<Item>(size_t)> code_gen_type;
 
+        struct check_solution_request {
+            mastermind_engine<Item>* engine;
+            const std::vector<Item>* solution;
+            std::optional<game_result> result;
+            std::exception_ptr error;
+        };
+
         mastermind_engine() = delete;
-        explicit mastermind_engine(code_gen_type code_pattern_generator);
+        explicit mastermind_engine(code_gen_type code_pattern_generator, code_rule rule = code_rule::DISTINCT_VALUES);
         mastermind_engine(const mastermind_engine<Item>&) = delete;
         mastermind_engine<Item>& operator=(const mastermind_engine<Item>&) = delete;
         mastermind_engine(mastermind_engine<Item>&& me);
@@ -26,26 +46,35 @@ namespace mastermind {
         std::optional<std::reference_wrapper<const std::vector<Item>>> get_correct_solution() const;
         size_t get_tries_left() const { return m_tries_left; }
         game_status get_status() const { return m_status; }
+        code_rule get_code_rule() const { return m_rule; }
 
         void start_game(game_start_params start_params);
         std::optional<game_result> check_solution(const std::vector<Item>& s);
+        static void check_solutions(check_solution_request* requests, size_t count);
+
+        engine_state<Item> save_state() const;
+        void restore_state(engine_state<Item> state);
 
         ~mastermind_engine() = default;
 
     private:
         code_gen_type m_code_generator;
+        code_rule m_rule{ code_rule::DISTINCT_VALUES };
         game_status m_status{ game_status::NOT_INITIALIZED };
         std::vector<Item> m_code_pattern{};
         size_t m_tries_left{ 0 };
         game_result m_current_result{ false, 0, 0 };
 
-        std::optional<game_result> get_game_result(const std::vector<Item> &s);
+        void validate_solution(const std::vector<Item>& s) const;
+        bool are_values_allowed(const std::vector<Item>& s) const;
+        template<typename Scorer>
+        std::optional<game_result> get_game_result(Scorer score);
         game_result compute_game_result(const std::vector<Item> &s) const;
     };
 
     template <typename Item>
-    mastermind_engine<Item>::mastermind_engine(code_gen_type code_pattern_generator)
-        : m_code_generator{ code_pattern_generator } {
+    mastermind_engine<Item>::mastermind_engine(code_gen_type code_pattern_generator, code_rule rule)
+        : m_code_generator{ code_pattern_generator }, m_rule{ rule } {
     }
 
     template <typename Item>
@@ -56,6 +85,7 @@ namespace mastermind {
     template <typename Item>
     mastermind_engine<Item>& mastermind_engine<Item>::operator=(mastermind_engine&& me) {
         m_code_generator = me.m_code_generator;
+        m_rule = me.m_rule;
         m_status = me.m_status;
         m_tries_left = me.m_tries_left;
         m_code_pattern = std::move(me.m_code_pattern);
@@ -79,44 +109,146 @@ namespace mastermind {
 
     template <typename Item>
     void mastermind_engine<Item>::start_game(game_start_params start_params) {
+        scoped_latency latency{ metric_histogram::START_GAME_LATENCY };
+
         if (start_params.max_tries == 0) {
+            count_metric(metric_counter::ZERO_MAX_TRIES_ERRORS);
             throw zero_max_tries_value_error();
         }
 
         m_code_pattern = std::move(m_code_generator(start_params.code_size));
 
-        if (!are_all_values_different(m_code_pattern)) {
+        if (!are_values_allowed(m_code_pattern)) {
+            count_metric(metric_counter::INDISTINCT_VALUES_ERRORS);
             throw indistinct_values_error();
         }
 
         m_tries_left = start_params.max_tries;
         m_status = game_status::IN_GAME;
+        count_metric(metric_counter::GAMES_STARTED);
     }
 
     template <typename Item>
     std::optional<game_result> mastermind_engine<Item>::check_solution(const std::vector<Item>& s) {
+        scoped_latency latency{ metric_histogram::CHECK_SOLUTION_LATENCY };
+        validate_solution(s);
+
+        return (m_status == game_status::NOT_INITIALIZED) ? std::nullopt : get_game_result([&]() { return compute_game_result(s); });
+    }
+
+    // Same outcome as calling check_solution on every request in order, but all guesses
+    // of distinct-value games are scored together before the engines are updated.
+    // Errors are stored in the request instead of thrown. Every request records an
+    // equal share of the batch's time as its check solution latency.
+    template <typename Item>
+    void mastermind_engine<Item>::check_solutions(check_solution_request* requests, size_t count) {
+        MASTERMIND_PERF_SCOPE("engine.check_solutions");
+        const auto begin = std::chrono::steady_clock::now();
+        std::vector<game_result> computed(count, game_result{ false, 0, 0 });
+        std::vector<size_t> batched{};
+        std::vector<const Item*> code_patterns{};
+        std::vector<const Item*> guesses{};
+        std::vector<size_t> sizes{};
+
+        for (size_t i{ 0 }; i < count; ++i) {
+            check_solution_request& request = requests[i];
+            mastermind_engine<Item>& engine = *request.engine;
+            try {
+                engine.validate_solution(*request.solution);
+            }
+            catch (...) {
+                request.error = std::current_exception();
+                continue;
+            }
+
+            if (engine.m_rule == code_rule::REPEATED_VALUES) {
+                computed[i] = compute_game_result_with_repeats(engine.m_code_pattern, *request.solution);
+            }
+            else {
+                batched.push_back(i);
+                code_patterns.push_back(engine.m_code_pattern.data());
+                guesses.push_back(request.solution->data());
+                sizes.push_back(engine.m_code_pattern.size());
+            }
+        }
+
+        std::vector<game_result> results(batched.size(), game_result{ false, 0, 0 });
+        compute_game_results(code_patterns.data(), guesses.data(), sizes.data(), batched.size(), results.data());
+        for (size_t j{ 0 }; j < batched.size(); ++j) {
+            computed[batched[j]] = results[j];
+        }
+
+        for (size_t i{ 0 }; i < count; ++i) {
+            check_solution_request& request = requests[i];
+            mastermind_engine<Item>& engine = *request.engine;
+            if (!request.error && engine.m_status != game_status::NOT_INITIALIZED) {
+                request.result = engine.get_game_result([&]() { return computed[i]; });
+            }
+        }
+
+        if (metrics_enabled && count > 0) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+            for (size_t i{ 0 }; i < count; ++i) {
+                record_metric(metric_histogram::CHECK_SOLUTION_LATENCY, static_cast<std::uint64_t>(elapsed.count()) / count);
+            }
+        }
+    }
+
+    template <typename Item>
+    engine_state<Item> mastermind_engine<Item>::save_state() const {
+        return { m_status, m_code_pattern, m_tries_left, m_current_result, m_rule };
+    }
+
+    template <typename Item>
+    void mastermind_engine<Item>::restore_state(engine_state<Item> state) {
+        if (state.rule != m_rule) {
+            throw code_rule_mismatch_error();
+        }
+        if (!are_values_allowed(state.code_pattern)) {
+            throw indistinct_values_error();
+        }
+        if (state.status == game_status::IN_GAME && state.tries_left == 0) {
+            throw zero_max_tries_value_error();
+        }
+
+        m_status = state.status;
+        m_code_pattern = std::move(state.code_pattern);
+        m_tries_left = (m_status == game_status::IN_GAME) ? state.tries_left : 0;
+        m_current_result = state.current_result;
+    }
+
+    template <typename Item>
+    void mastermind_engine<Item>::validate_solution(const std::vector<Item>& s) const {
+        MASTERMIND_PERF_SCOPE("engine.validate_solution");
+
         if (s.size() != m_code_pattern.size()) {
+            count_metric(metric_counter::INCORRECT_CODE_SIZE_ERRORS);
             throw mastermind::incorrect_code_size_error{ s.size(), m_code_pattern.size() };
         }
 
-        if (!are_all_values_different(s)) {
+        if (!are_values_allowed(s)) {
+            count_metric(metric_counter::INDISTINCT_VALUES_ERRORS);
             throw indistinct_values_error();
         }
-
-        return (m_status == game_status::NOT_INITIALIZED) ? std::nullopt : get_game_result(s);
     }
 
     template<typename Item>
-    std::optional<game_result> mastermind_engine<Item>::get_game_result(const std::vector<Item> &s)
+    template<typename Scorer>
+    std::optional<game_result> mastermind_engine<Item>::get_game_result(Scorer score)
     {
         if (m_status == game_status::IN_GAME) {
-            m_current_result = compute_game_result(s);
+            m_current_result = score();
+            count_metric(metric_counter::GUESSES_SCORED);
 
             if (m_current_result.valid) {
                 m_tries_left = 0;
+                count_metric(metric_counter::GAMES_WON);
             }
             else {
                 --m_tries_left;
+                if (m_tries_left == 0) {
+                    count_metric(metric_counter::GAMES_LOST);
+                }
             }
         }
 
@@ -129,23 +261,15 @@ namespace mastermind {
 
     template<typename Item>
     game_result mastermind_engine<Item>::compute_game_result(const std::vector<Item> &s) const {
-        size_t in_place{ 0 };
-        size_t in_color{ 0 };
-
-        for (size_t i = 0; i < s.size(); ++i) {
-            for (size_t j = 0; j < m_code_pattern.size(); ++j) {
-                if (s[i] == m_code_pattern[j]) {
-                    if (i == j) {
-                        ++in_place;
-                    }
-                    else {
-                        ++in_color;
-                    }
-                    break;
-                }
-            }
+        MASTERMIND_PERF_SCOPE("engine.compute_game_result");
+        if (m_rule == code_rule::REPEATED_VALUES) {
+            return compute_game_result_with_repeats(m_code_pattern, s);
         }
+        return ::mastermind::compute_game_result(m_code_pattern, s);
+    }
 
-        return game_result{ (in_place == m_code_pattern.size()), in_place, in_color };
+    template<typename Item>
+    bool mastermind_engine<Item>::are_values_allowed(const std::vector<Item>& s) const {
+        return m_rule == code_rule::REPEATED_VALUES || are_all_values_different(s);
     }
 }
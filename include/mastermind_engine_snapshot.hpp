@@ -0,0 +1,240 @@
+#pragma once
+
+#include "mastermind_engine.hpp"
+#include "mastermind_exceptions.hpp"
+#include "mastermind_file_utils.hpp"
+#include "mastermind_utils.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace mastermind {
+
+    // Layout: an engine_snapshot_header, one fixed-width engine_snapshot_entry per
+    // session, then the code patterns of all sessions back to back as raw values. Every
+    // part starts at a multiple of 8 bytes, so a mapped snapshot is read in place.
+    struct engine_snapshot_header {
+        char magic[8];
+        std::uint16_t version;
+        std::uint16_t value_size;
+        std::uint32_t byte_order;
+        std::uint64_t sessions;
+        std::uint64_t code_values;
+    };
+
+    struct engine_snapshot_entry {
+        std::uint64_t tries_left;
+        std::uint64_t code_offset;
+        std::uint32_t code_size;
+        std::uint16_t pegs_in_right_place;
+        std::uint16_t pegs_in_right_color;
+        std::uint8_t status;
+        std::uint8_t valid;
+        std::uint8_t rule;
+        std::uint8_t reserved[5];
+    };
+
+    static_assert(sizeof(engine_snapshot_header) == 32, "engine_snapshot_header must be 32 bytes");
+    static_assert(sizeof(engine_snapshot_entry) == 32, "engine_snapshot_entry must be 32 bytes");
+
+    constexpr char engine_snapshot_magic[8]{ 'M', 'M', 'E', 'N', 'G', 'S', 'N', 'P' };
+    constexpr std::uint16_t engine_snapshot_version{ 2 };
+    constexpr std::uint32_t engine_snapshot_byte_order{ 0x01020304 };
+
+    // Collects the state of any number of engines and serializes them in one buffer.
+    template<typename Item>
+    class engine_snapshot_writer {
+    public:
+        static_assert(std::is_trivially_copyable<Item>::value && alignof(Item) <= 8,
+            "engine snapshots store values as raw bytes");
+
+        void add(const mastermind_engine<Item>& engine);
+        size_t size() const { return m_entries.size(); }
+
+        std::vector<unsigned char> serialize() const;
+        void save(const std::string& path) const;
+
+    private:
+        std::vector<engine_snapshot_entry> m_entries{};
+        std::vector<Item> m_codes{};
+    };
+
+    template<typename Item>
+    void engine_snapshot_writer<Item>::add(const mastermind_engine<Item>& engine) {
+        engine_state<Item> state = engine.save_state();
+
+        engine_snapshot_entry entry{};
+        entry.tries_left = state.tries_left;
+        entry.code_offset = m_codes.size();
+        entry.code_size = static_cast<std::uint32_t>(state.code_pattern.size());
+        entry.pegs_in_right_place = static_cast<std::uint16_t>(state.current_result.pegs_in_right_place);
+        entry.pegs_in_right_color = static_cast<std::uint16_t>(state.current_result.pegs_in_right_color);
+        entry.status = static_cast<std::uint8_t>(state.status);
+        entry.valid = state.current_result.valid ? 1 : 0;
+        entry.rule = static_cast<std::uint8_t>(state.rule);
+
+        m_entries.push_back(entry);
+        m_codes.insert(m_codes.end(), state.code_pattern.begin(), state.code_pattern.end());
+    }
+
+    template<typename Item>
+    std::vector<unsigned char> engine_snapshot_writer<Item>::serialize() const {
+        engine_snapshot_header header{};
+        std::memcpy(header.magic, engine_snapshot_magic, sizeof(header.magic));
+        header.version = engine_snapshot_version;
+        header.value_size = static_cast<std::uint16_t>(sizeof(Item));
+        header.byte_order = engine_snapshot_byte_order;
+        header.sessions = m_entries.size();
+        header.code_values = m_codes.size();
+
+        const size_t entries_size = m_entries.size() * sizeof(engine_snapshot_entry);
+        const size_t codes_size = m_codes.size() * sizeof(Item);
+        std::vector<unsigned char> buffer(sizeof(header) + entries_size + codes_size);
+        std::memcpy(buffer.data(), &header, sizeof(header));
+        if (entries_size > 0) {
+            std::memcpy(buffer.data() + sizeof(header), m_entries.data(), entries_size);
+        }
+        if (codes_size > 0) {
+            std::memcpy(buffer.data() + sizeof(header) + entries_size, m_codes.data(), codes_size);
+        }
+        return buffer;
+    }
+
+    template<typename Item>
+    void engine_snapshot_writer<Item>::save(const std::string& path) const {
+        std::vector<unsigned char> buffer = serialize();
+
+        try {
+            write_file_atomically(path, buffer.data(), buffer.size());
+        }
+        catch (const std::runtime_error& error) {
+            throw engine_snapshot_error{ error.what() };
+        }
+    }
+
+    // Validates a serialized snapshot once and then reads its sessions straight from the
+    // given bytes, which must stay alive and be 8-byte aligned.
+    template<typename Item>
+    class engine_snapshot_view {
+    public:
+        static_assert(std::is_trivially_copyable<Item>::value && alignof(Item) <= 8,
+            "engine snapshots store values as raw bytes");
+
+        engine_snapshot_view(const void* data, size_t size);
+
+        size_t size() const { return m_count; }
+        game_status get_status(size_t session) const { return static_cast<game_status>(m_entries[session].status); }
+        const Item* get_code_pattern(size_t session) const { return m_codes + m_entries[session].code_offset; }
+        size_t get_code_size(size_t session) const { return m_entries[session].code_size; }
+
+        engine_state<Item> get_state(size_t session) const;
+        void restore(size_t session, mastermind_engine<Item>& engine) const { engine.restore_state(get_state(session)); }
+
+    private:
+        const engine_snapshot_entry* m_entries{ nullptr };
+        const Item* m_codes{ nullptr };
+        size_t m_count{ 0 };
+    };
+
+    template<typename Item>
+    engine_snapshot_view<Item>::engine_snapshot_view(const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        if (size < sizeof(engine_snapshot_header) || reinterpret_cast<std::uintptr_t>(bytes) % 8 != 0) {
+            throw engine_snapshot_error{ "buffer is not an aligned snapshot" };
+        }
+
+        engine_snapshot_header header{};
+        std::memcpy(&header, bytes, sizeof(header));
+        if (std::memcmp(header.magic, engine_snapshot_magic, sizeof(header.magic)) != 0
+            || header.version != engine_snapshot_version || header.byte_order != engine_snapshot_byte_order) {
+            throw engine_snapshot_error{ "unsupported header" };
+        }
+        if (header.value_size != sizeof(Item)) {
+            throw engine_snapshot_error{ "values of " + std::to_string(header.value_size) + " bytes, expected " + std::to_string(sizeof(Item)) };
+        }
+
+        const size_t available = size - sizeof(header);
+        if (header.sessions > available / sizeof(engine_snapshot_entry)
+            || header.code_values > (available - header.sessions * sizeof(engine_snapshot_entry)) / sizeof(Item)) {
+            throw engine_snapshot_error{ "truncated snapshot" };
+        }
+
+        m_count = static_cast<size_t>(header.sessions);
+        m_entries = reinterpret_cast<const engine_snapshot_entry*>(bytes + sizeof(header));
+        m_codes = reinterpret_cast<const Item*>(bytes + sizeof(header) + m_count * sizeof(engine_snapshot_entry));
+
+        for (size_t i{ 0 }; i < m_count; ++i) {
+            const engine_snapshot_entry& entry = m_entries[i];
+            if (entry.status > static_cast<std::uint8_t>(game_status::ENDED)
+                || entry.rule > static_cast<std::uint8_t>(code_rule::REPEATED_VALUES)
+                || (entry.status == static_cast<std::uint8_t>(game_status::IN_GAME) && entry.tries_left == 0)
+                || entry.code_offset > header.code_values || entry.code_size > header.code_values - entry.code_offset) {
+                throw engine_snapshot_error{ "malformed session " + std::to_string(i) };
+            }
+        }
+    }
+
+    template<typename Item>
+    engine_state<Item> engine_snapshot_view<Item>::get_state(size_t session) const {
+        const engine_snapshot_entry& entry = m_entries[session];
+        const Item* code = m_codes + entry.code_offset;
+        return { static_cast<game_status>(entry.status), std::vector<Item>(code, code + entry.code_size),
+            static_cast<size_t>(entry.tries_left),
+            { entry.valid != 0, entry.pegs_in_right_place, entry.pegs_in_right_color },
+            static_cast<code_rule>(entry.rule) };
+    }
+
+    // Read-only memory mapping of a snapshot file.
+    template<typename Item>
+    class engine_snapshot_file {
+    public:
+        explicit engine_snapshot_file(const std::string& path) : m_mapping{ path }, m_view{ m_mapping.data, m_mapping.length } {}
+
+        const engine_snapshot_view<Item>& view() const { return m_view; }
+
+    private:
+        struct mapping {
+            void* data{ nullptr };
+            size_t length{ 0 };
+
+            explicit mapping(const std::string& path);
+            mapping(const mapping&) = delete;
+            mapping& operator=(const mapping&) = delete;
+            ~mapping() { ::munmap(data, length); }
+        };
+
+        mapping m_mapping;
+        engine_snapshot_view<Item> m_view;
+    };
+
+    template<typename Item>
+    engine_snapshot_file<Item>::mapping::mapping(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw engine_snapshot_error{ "cannot open " + path + ": " + std::strerror(errno) };
+        }
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(engine_snapshot_header)) {
+            ::close(fd);
+            throw engine_snapshot_error{ path + " is not a snapshot" };
+        }
+
+        length = static_cast<size_t>(st.st_size);
+        data = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            throw engine_snapshot_error{ std::string{ "mmap failed: " } + std::strerror(errno) };
+        }
+    }
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <stdexcept>
 #include <string>
 
@@ -20,6 +21,13 @@ namespace mastermind {
         {}
     };
 
+    class max_tries_too_large_error : public std::logic_error {
+    public:
+        max_tries_too_large_error(size_t max_tries, size_t max_supported_tries)
+            : ::std::logic_error{ "Max tries value is " + std::to_string(max_tries) + " but at most " + std::to_string(max_supported_tries) + " is supported" }
+        {}
+    };
+
     class indistinct_values_error : public std::logic_error {
     public:
         indistinct_values_error()
@@ -27,4 +35,81 @@ namespace mastermind {
         {}
     };
 
+    class code_set_too_small_error : public std::logic_error {
+    public:
+        code_set_too_small_error(size_t code_size, size_t code_set_size)
+            : ::std::logic_error{ "Code size " + std::to_string(code_size) + " exceeds the code set size " + std::to_string(code_set_size) }
+        {}
+    };
+
+    class value_not_in_code_set_error : public std::logic_error {
+    public:
+        value_not_in_code_set_error()
+            : ::std::logic_error{ "Value of the code is not in the code set" }
+        {}
+    };
+
+    class code_set_too_large_error : public std::logic_error {
+    public:
+        code_set_too_large_error(size_t code_set_size, size_t max_code_set_size)
+            : ::std::logic_error{ "Code set size is " + std::to_string(code_set_size) + " but at most " + std::to_string(max_code_set_size) + " values are supported" }
+        {}
+    };
+
+    class code_space_too_large_error : public std::logic_error {
+    public:
+        code_space_too_large_error(size_t code_set_size, size_t code_size)
+            : ::std::logic_error{ "Code space of " + std::to_string(code_size) + " values out of " + std::to_string(code_set_size) + " is too large" }
+        {}
+    };
+
+    class code_rule_mismatch_error : public std::logic_error {
+    public:
+        code_rule_mismatch_error()
+            : ::std::logic_error{ "State was saved by an engine with a different code rule" }
+        {}
+    };
+
+    class empty_difficulty_band_error : public std::logic_error {
+    public:
+        empty_difficulty_band_error(size_t min_difficulty, size_t max_difficulty)
+            : ::std::logic_error{ "No code needs between " + std::to_string(min_difficulty) + " and " + std::to_string(max_difficulty) + " guesses" }
+        {}
+    };
+
+    class game_log_error : public std::runtime_error {
+    public:
+        explicit game_log_error(const std::string& message)
+            : ::std::runtime_error{ "Game log: " + message }
+        {}
+    };
+
+    class engine_snapshot_error : public std::runtime_error {
+    public:
+        explicit engine_snapshot_error(const std::string& message)
+            : ::std::runtime_error{ "Engine snapshot: " + message }
+        {}
+    };
+
+    class shm_transport_error : public std::runtime_error {
+    public:
+        explicit shm_transport_error(const std::string& message)
+            : ::std::runtime_error{ "Shared memory transport: " + message }
+        {}
+    };
+
+    class shard_runner_error : public std::runtime_error {
+    public:
+        explicit shard_runner_error(const std::string& message)
+            : ::std::runtime_error{ "Shard runner: " + message }
+        {}
+    };
+
+    class difficulty_index_error : public std::runtime_error {
+    public:
+        explicit difficulty_index_error(const std::string& message)
+            : ::std::runtime_error{ "Difficulty index: " + message }
+        {}
+    };
+
 }
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+
+namespace mastermind {
+
+    // Writes the bytes to <path>.tmp, syncs it and renames it over path, so the file on
+    // disk is always either the old or the new content. The temporary file is removed
+    // on every error, which is thrown as std::runtime_error for the caller to rewrap.
+    inline void write_file_atomically(const std::string& path, const void* bytes, size_t size) {
+        const std::string temporary = path + ".tmp";
+        auto fail = [&temporary](const std::string& message) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error{ message };
+        };
+
+#ifndef _WIN32
+        int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw std::runtime_error{ "cannot open " + temporary + ": " + std::strerror(errno) };
+        }
+        const char* data = static_cast<const char*>(bytes);
+        size_t written{ 0 };
+        while (written < size) {
+            ssize_t n = ::write(fd, data + written, size - written);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                int error = errno;
+                ::close(fd);
+                fail("cannot write " + temporary + ": " + std::strerror(error));
+            }
+            written += static_cast<size_t>(n);
+        }
+        if (::fsync(fd) != 0) {
+            int error = errno;
+            ::close(fd);
+            fail("cannot sync " + temporary + ": " + std::strerror(error));
+        }
+        if (::close(fd) != 0) {
+            fail("cannot close " + temporary + ": " + std::strerror(errno));
+        }
+#else
+        {
+            std::ofstream out{ temporary, std::ios::binary | std::ios::trunc };
+            if (!out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size)) || !out.flush()) {
+                out.close();
+                fail("cannot write " + temporary);
+            }
+        }
+#endif
+        if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+            fail("cannot replace " + path + ": " + std::strerror(errno));
+        }
+    }
+
+}
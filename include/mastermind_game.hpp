@@ -1,6 +1,9 @@
 #pragma once
 
+#include "mastermind_game_observer.hpp"
+#include "mastermind_metrics.hpp"
 #include "mastermind_ui.hpp"
+#include "mastermind_utils.hpp"
 #include <functional>
 #include <optional>
 #include <vector>
@@ -8,17 +11,20 @@
 
 namespace mastermind {
 
-    template<typename GameEngine = mastermind_engine<typename Item>>
+    template<typename GameEngine>
     class mastermind_game {
     public:
         using ui_t = mastermind_ui<typename GameEngine::value_type>;
+        using observer_t = mastermind_game_observer<typename GameEngine::value_type>;
 
         mastermind_game(ui_t& ui, typename GameEngine::code_gen_type code_gen);
         void run();
+        void set_observer(observer_t* observer) { m_observer = observer; }
 
     private:
         mastermind_ui<typename GameEngine::value_type>& m_ui;
         GameEngine m_me;
+        observer_t* m_observer{ nullptr };
 
         void play_game();
         void initialize_game();
@@ -40,12 +46,20 @@ namespace mastermind {
 
     template<typename GameEngine>
     void mastermind_game<GameEngine>::play_game() {
+        count_metric(metric_counter::GAME_LOOP_GAMES);
         initialize_game();
 
         while (m_me.get_status() == game_status::IN_GAME) {
             show_tries_left_info();
             play_one_turn();
         }
+
+        if (m_observer != nullptr) {
+            auto correct_solution = m_me.get_correct_solution();
+            if (correct_solution.has_value()) {
+                m_observer->on_game_ended(correct_solution.value().get());
+            }
+        }
     }
 
     template<typename GameEngine>
@@ -53,6 +67,10 @@ namespace mastermind {
         m_ui.show_board();
         auto start_params = m_ui.get_start_params();
         m_me.start_game(start_params);
+
+        if (m_observer != nullptr) {
+            m_observer->on_game_started(start_params);
+        }
     }
 
     template<typename GameEngine>
@@ -64,9 +82,14 @@ namespace mastermind {
 
     template<typename GameEngine>
     void mastermind_game<GameEngine>::play_one_turn() {
+        count_metric(metric_counter::GAME_LOOP_TURNS);
         auto user_solution = m_ui.ask_for_solution();
         std::optional<game_result> result = m_me.check_solution(user_solution);
 
+        if (m_observer != nullptr) {
+            m_observer->on_guess_scored(user_solution, result.value());
+        }
+
         if (result.value().valid) {
             m_ui.show_winning_message();
         }
@@ -0,0 +1,416 @@
+#pragma once
+
+#include "mastermind_exceptions.hpp"
+#include "mastermind_game_observer.hpp"
+#include "mastermind_utils.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace mastermind {
+
+    // On-disk layout: a game_log_header followed by fixed-width game_log_records. Every
+    // game is stored contiguously as one GAME record holding the secret and the start
+    // parameters followed by one GUESS record per scored guess.
+    enum class game_log_record_kind : std::uint8_t {
+        GAME = 1,
+        GUESS = 2
+    };
+
+    struct game_log_header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t record_size;
+    };
+
+    struct game_log_record {
+        static constexpr size_t max_code_size{ 24 };
+
+        game_log_record_kind kind;
+        std::uint8_t code_size;
+        std::uint8_t pegs_in_right_place;
+        std::uint8_t pegs_in_right_color;
+        std::uint32_t max_tries;
+        std::uint8_t code[max_code_size];
+    };
+
+    static_assert(sizeof(game_log_header) == 16, "game_log_header must be 16 bytes");
+    static_assert(sizeof(game_log_record) == 32, "game_log_record must be 32 bytes");
+
+    constexpr char game_log_magic[8]{ 'M', 'M', 'G', 'A', 'M', 'E', 'L', 'G' };
+    constexpr std::uint32_t game_log_version{ 1 };
+
+    class game_log_writer {
+    public:
+        explicit game_log_writer(const std::string& path,
+            std::chrono::milliseconds fsync_interval = std::chrono::milliseconds{ 1000 },
+            size_t buffered_records = 4096);
+        game_log_writer(const game_log_writer&) = delete;
+        game_log_writer& operator=(const game_log_writer&) = delete;
+        ~game_log_writer();
+
+        void append(const game_log_record* records, size_t count);
+        void flush();
+        void sync();
+
+    private:
+        int m_fd{ -1 };
+        std::chrono::milliseconds m_fsync_interval;
+        std::chrono::steady_clock::time_point m_last_sync;
+        std::vector<game_log_record> m_buffer{};
+        size_t m_buffered_records;
+        std::mutex m_mutex{};
+
+        void write_all(const void* data, size_t size);
+        void flush_locked();
+    };
+
+    inline game_log_writer::game_log_writer(const std::string& path, std::chrono::milliseconds fsync_interval, size_t buffered_records)
+        : m_fsync_interval{ fsync_interval }, m_last_sync{ std::chrono::steady_clock::now() },
+        m_buffered_records{ std::max<size_t>(buffered_records, 1) } {
+        m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (m_fd < 0) {
+            throw game_log_error{ "cannot open " + path + ": " + std::strerror(errno) };
+        }
+
+        struct stat st {};
+        if (::fstat(m_fd, &st) == 0 && st.st_size == 0) {
+            game_log_header header{};
+            std::memcpy(header.magic, game_log_magic, sizeof(header.magic));
+            header.version = game_log_version;
+            header.record_size = sizeof(game_log_record);
+            write_all(&header, sizeof(header));
+        }
+        m_buffer.reserve(m_buffered_records);
+    }
+
+    inline game_log_writer::~game_log_writer() {
+        try {
+            sync();
+        }
+        catch (const game_log_error&) {
+        }
+        ::close(m_fd);
+    }
+
+    inline void game_log_writer::append(const game_log_record* records, size_t count) {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        if (m_buffer.size() + count > m_buffered_records) {
+            flush_locked();
+        }
+        if (count > m_buffered_records) {
+            write_all(records, count * sizeof(game_log_record));
+        }
+        else {
+            m_buffer.insert(m_buffer.end(), records, records + count);
+        }
+
+        if (std::chrono::steady_clock::now() - m_last_sync >= m_fsync_interval) {
+            flush_locked();
+            ::fsync(m_fd);
+            m_last_sync = std::chrono::steady_clock::now();
+        }
+    }
+
+    inline void game_log_writer::flush() {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        flush_locked();
+    }
+
+    inline void game_log_writer::sync() {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        flush_locked();
+        ::fsync(m_fd);
+        m_last_sync = std::chrono::steady_clock::now();
+    }
+
+    inline void game_log_writer::flush_locked() {
+        if (!m_buffer.empty()) {
+            write_all(m_buffer.data(), m_buffer.size() * sizeof(game_log_record));
+            m_buffer.clear();
+        }
+    }
+
+    inline void game_log_writer::write_all(const void* data, size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t written = ::write(m_fd, bytes, size);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw game_log_error{ std::string{ "write failed: " } + std::strerror(errno) };
+            }
+            bytes += written;
+            size -= static_cast<size_t>(written);
+        }
+    }
+
+    // Observer recording the games of one mastermind_game. The records of a game are
+    // kept until the game ends, because the secret is only known then, and are appended
+    // in one call so that games of concurrent recorders never interleave. A game with a
+    // code, value or max tries that does not fit in a record is left out of the log and
+    // counted instead of interrupting play.
+    template<typename Item>
+    class game_log_recorder : public mastermind_game_observer<Item> {
+    public:
+        static_assert(std::is_integral<Item>::value, "game_log_recorder stores values as bytes");
+
+        explicit game_log_recorder(game_log_writer& writer) : m_writer{ writer } {}
+
+        void on_game_started(game_start_params start_params) override;
+        void on_guess_scored(const std::vector<Item>& guess, game_result result) override;
+        void on_game_ended(const std::vector<Item>& code_pattern) override;
+
+        std::uint64_t get_skipped_games() const { return m_skipped_games; }
+        const std::string& get_last_skip_reason() const { return m_last_skip_reason; }
+
+    private:
+        game_log_writer& m_writer;
+        game_start_params m_start_params{ 0, 0 };
+        std::vector<game_log_record> m_records{};
+        bool m_skipping{ false };
+        std::uint64_t m_skipped_games{ 0 };
+        std::string m_last_skip_reason{};
+
+        void skip_game(const std::string& reason);
+        static std::optional<game_log_record> make_record(game_log_record_kind kind, const std::vector<Item>& code, std::string& reason);
+    };
+
+    template<typename Item>
+    void game_log_recorder<Item>::on_game_started(game_start_params start_params) {
+        m_start_params = start_params;
+        m_records.clear();
+        m_skipping = false;
+        if (start_params.code_size > game_log_record::max_code_size) {
+            skip_game("code of " + std::to_string(start_params.code_size) + " values does not fit in a record");
+            return;
+        }
+        if (start_params.max_tries > std::numeric_limits<std::uint32_t>::max()) {
+            skip_game("max tries value " + std::to_string(start_params.max_tries) + " does not fit in a record");
+            return;
+        }
+        m_records.push_back(game_log_record{});
+    }
+
+    template<typename Item>
+    void game_log_recorder<Item>::on_guess_scored(const std::vector<Item>& guess, game_result result) {
+        if (m_skipping || m_records.empty()) {
+            return;
+        }
+
+        std::string reason{};
+        std::optional<game_log_record> record = make_record(game_log_record_kind::GUESS, guess, reason);
+        if (!record) {
+            skip_game(reason);
+            return;
+        }
+        record->pegs_in_right_place = static_cast<std::uint8_t>(result.pegs_in_right_place);
+        record->pegs_in_right_color = static_cast<std::uint8_t>(result.pegs_in_right_color);
+        m_records.push_back(record.value());
+    }
+
+    template<typename Item>
+    void game_log_recorder<Item>::on_game_ended(const std::vector<Item>& code_pattern) {
+        if (m_skipping || m_records.empty()) {
+            return;
+        }
+
+        std::string reason{};
+        std::optional<game_log_record> game = make_record(game_log_record_kind::GAME, code_pattern, reason);
+        if (!game) {
+            skip_game(reason);
+            return;
+        }
+        m_records.front() = game.value();
+        m_records.front().max_tries = static_cast<std::uint32_t>(m_start_params.max_tries);
+        m_writer.append(m_records.data(), m_records.size());
+        m_records.clear();
+    }
+
+    template<typename Item>
+    void game_log_recorder<Item>::skip_game(const std::string& reason) {
+        ++m_skipped_games;
+        m_last_skip_reason = reason;
+        m_skipping = true;
+        m_records.clear();
+    }
+
+    template<typename Item>
+    std::optional<game_log_record> game_log_recorder<Item>::make_record(game_log_record_kind kind, const std::vector<Item>& code, std::string& reason) {
+        if (code.size() > game_log_record::max_code_size) {
+            reason = "code of " + std::to_string(code.size()) + " values does not fit in a record";
+            return std::nullopt;
+        }
+
+        game_log_record record{};
+        record.kind = kind;
+        record.code_size = static_cast<std::uint8_t>(code.size());
+        for (size_t i{ 0 }; i < code.size(); ++i) {
+            bool negative{ false };
+            if constexpr (std::is_signed<Item>::value) {
+                negative = code[i] < 0;
+            }
+            if (negative || static_cast<std::uint64_t>(code[i]) > std::numeric_limits<std::uint8_t>::max()) {
+                reason = "value " + std::to_string(code[i]) + " does not fit in a byte";
+                return std::nullopt;
+            }
+            record.code[i] = static_cast<std::uint8_t>(code[i]);
+        }
+        return record;
+    }
+
+    struct game_log_replay_result {
+        std::uint64_t games{ 0 };
+        std::uint64_t guesses{ 0 };
+        std::uint64_t mismatches{ 0 };
+        std::uint64_t malformed_records{ 0 };
+
+        game_log_replay_result& operator+=(const game_log_replay_result& other) {
+            games += other.games;
+            guesses += other.guesses;
+            mismatches += other.mismatches;
+            malformed_records += other.malformed_records;
+            return *this;
+        }
+    };
+
+    // Read-only memory mapping of a game log.
+    class game_log_reader {
+    public:
+        explicit game_log_reader(const std::string& path);
+        game_log_reader(const game_log_reader&) = delete;
+        game_log_reader& operator=(const game_log_reader&) = delete;
+        ~game_log_reader();
+
+        const game_log_record* records() const { return m_records; }
+        size_t size() const { return m_count; }
+
+    private:
+        void* m_data{ nullptr };
+        size_t m_length{ 0 };
+        const game_log_record* m_records{ nullptr };
+        size_t m_count{ 0 };
+    };
+
+    inline game_log_reader::game_log_reader(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw game_log_error{ "cannot open " + path + ": " + std::strerror(errno) };
+        }
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(game_log_header)) {
+            ::close(fd);
+            throw game_log_error{ path + " is not a game log" };
+        }
+
+        m_length = static_cast<size_t>(st.st_size);
+        m_data = ::mmap(nullptr, m_length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (m_data == MAP_FAILED) {
+            m_data = nullptr;
+            throw game_log_error{ std::string{ "mmap failed: " } + std::strerror(errno) };
+        }
+
+        game_log_header header{};
+        std::memcpy(&header, m_data, sizeof(header));
+        if (std::memcmp(header.magic, game_log_magic, sizeof(header.magic)) != 0
+            || header.version != game_log_version || header.record_size != sizeof(game_log_record)) {
+            ::munmap(m_data, m_length);
+            throw game_log_error{ path + " has an unsupported header" };
+        }
+
+        ::madvise(m_data, m_length, MADV_SEQUENTIAL);
+        m_records = reinterpret_cast<const game_log_record*>(static_cast<const char*>(m_data) + sizeof(game_log_header));
+        m_count = (m_length - sizeof(game_log_header)) / sizeof(game_log_record);
+    }
+
+    inline game_log_reader::~game_log_reader() {
+        if (m_data != nullptr) {
+            ::munmap(m_data, m_length);
+        }
+    }
+
+    // Re-scores every guess of the records [first, last). The count-min scoring agrees
+    // with compute_game_result on distinct codes and also covers games with repeats.
+    inline game_log_replay_result replay_game_log_range(const game_log_record* first, const game_log_record* last) {
+        game_log_replay_result result{};
+        const game_log_record* game{ nullptr };
+
+        for (const game_log_record* r{ first }; r != last; ++r) {
+            if (r->kind == game_log_record_kind::GAME && r->code_size <= game_log_record::max_code_size) {
+                game = r;
+                ++result.games;
+            }
+            else if (r->kind == game_log_record_kind::GUESS) {
+                if (game == nullptr) {
+                    ++result.malformed_records;
+                    continue;
+                }
+                ++result.guesses;
+                if (r->code_size != game->code_size) {
+                    ++result.mismatches;
+                    continue;
+                }
+                game_result expected = compute_game_result_with_repeats(game->code, r->code, game->code_size);
+                if (expected.pegs_in_right_place != r->pegs_in_right_place || expected.pegs_in_right_color != r->pegs_in_right_color) {
+                    ++result.mismatches;
+                }
+            }
+            else {
+                ++result.malformed_records;
+            }
+        }
+        return result;
+    }
+
+    // Splits the records into one range per thread, each starting at a GAME record so
+    // that no game is shared between threads, and replays the ranges in parallel.
+    inline game_log_replay_result replay_game_log(const game_log_record* records, size_t count, size_t threads = std::thread::hardware_concurrency()) {
+        threads = std::max<size_t>(1, std::min<size_t>(threads, count / 1024 + 1));
+
+        std::vector<size_t> bounds{ 0 };
+        for (size_t t{ 1 }; t < threads; ++t) {
+            size_t start = std::max(bounds.back(), count * t / threads);
+            while (start < count && records[start].kind != game_log_record_kind::GAME) {
+                ++start;
+            }
+            bounds.push_back(start);
+        }
+        bounds.push_back(count);
+
+        std::vector<game_log_replay_result> partial(threads);
+        std::vector<std::thread> workers{};
+        for (size_t t{ 0 }; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                partial[t] = replay_game_log_range(records + bounds[t], records + bounds[t + 1]);
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        game_log_replay_result total{};
+        for (const game_log_replay_result& p : partial) {
+            total += p;
+        }
+        return total;
+    }
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "mastermind_utils.hpp"
+#include <vector>
+
+
+namespace mastermind {
+
+    template <typename Item>
+    class mastermind_game_observer {
+    public:
+        virtual void on_game_started(game_start_params) = 0;
+        virtual void on_guess_scored(const std::vector<Item>&, game_result) = 0;
+        virtual void on_game_ended(const std::vector<Item>&) = 0;
+        virtual ~mastermind_game_observer() = 0;
+    };
+
+    template<typename Item>
+    mastermind_game_observer<Item>::~mastermind_game_observer<Item>()
+    {}
+
+}
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace mastermind {
+
+    enum class metric_counter {
+        GAMES_STARTED,
+        GAMES_WON,
+        GAMES_LOST,
+        GUESSES_SCORED,
+        INCORRECT_CODE_SIZE_ERRORS,
+        INDISTINCT_VALUES_ERRORS,
+        ZERO_MAX_TRIES_ERRORS,
+        GAME_LOOP_GAMES,
+        GAME_LOOP_TURNS,
+        COUNT
+    };
+
+    enum class metric_histogram {
+        START_GAME_LATENCY,
+        CHECK_SOLUTION_LATENCY,
+        COUNT
+    };
+
+    constexpr size_t metric_counters_count{ static_cast<size_t>(metric_counter::COUNT) };
+    constexpr size_t metric_histograms_count{ static_cast<size_t>(metric_histogram::COUNT) };
+
+    inline const char* metric_name(metric_counter counter) {
+        static const char* const names[metric_counters_count]{
+            "mastermind_games_started_total",
+            "mastermind_games_won_total",
+            "mastermind_games_lost_total",
+            "mastermind_guesses_scored_total",
+            "mastermind_incorrect_code_size_errors_total",
+            "mastermind_indistinct_values_errors_total",
+            "mastermind_zero_max_tries_errors_total",
+            "mastermind_game_loop_games_total",
+            "mastermind_game_loop_turns_total"
+        };
+        return names[static_cast<size_t>(counter)];
+    }
+
+    inline const char* metric_name(metric_histogram histogram) {
+        static const char* const names[metric_histograms_count]{
+            "mastermind_start_game_latency_ns",
+            "mastermind_check_solution_latency_ns"
+        };
+        return names[static_cast<size_t>(histogram)];
+    }
+
+    // Log-linear bucketing: values below 2^sub_bucket_bits get a bucket each, every
+    // further power of two is split into 2^sub_bucket_bits equal buckets, which keeps
+    // the relative error of a bucket under 1 / 2^sub_bucket_bits.
+    struct log_linear_buckets {
+        static constexpr size_t sub_bucket_bits{ 3 };
+        static constexpr size_t sub_buckets{ size_t{ 1 } << sub_bucket_bits };
+        static constexpr size_t count{ (64 - sub_bucket_bits + 1) * sub_buckets };
+
+        static size_t index(std::uint64_t value) {
+            if (value < sub_buckets) {
+                return static_cast<size_t>(value);
+            }
+            size_t magnitude = highest_bit(value);
+            size_t shift = magnitude - sub_bucket_bits;
+            return (shift + 1) * sub_buckets + static_cast<size_t>((value >> shift) & (sub_buckets - 1));
+        }
+
+        static size_t highest_bit(std::uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<size_t>(63 - __builtin_clzll(value));
+#else
+            size_t magnitude = 63;
+            while ((value >> magnitude) == 0) {
+                --magnitude;
+            }
+            return magnitude;
+#endif
+        }
+
+        static std::uint64_t upper_bound(size_t index) {
+            if (index < sub_buckets) {
+                return index;
+            }
+            size_t shift = index / sub_buckets - 1;
+            std::uint64_t base = (sub_buckets + index % sub_buckets) << shift;
+            return base + ((std::uint64_t{ 1 } << shift) - 1);
+        }
+    };
+
+    struct histogram_snapshot {
+        std::vector<std::uint64_t> buckets = std::vector<std::uint64_t>(log_linear_buckets::count, 0);
+        std::uint64_t count{ 0 };
+        std::uint64_t sum{ 0 };
+
+        std::uint64_t percentile(double q) const {
+            if (count == 0) {
+                return 0;
+            }
+            std::uint64_t rank = static_cast<std::uint64_t>(q * static_cast<double>(count - 1)) + 1;
+            std::uint64_t seen{ 0 };
+            for (size_t i{ 0 }; i < buckets.size(); ++i) {
+                seen += buckets[i];
+                if (seen >= rank) {
+                    return log_linear_buckets::upper_bound(i);
+                }
+            }
+            return log_linear_buckets::upper_bound(buckets.size() - 1);
+        }
+    };
+
+    struct metrics_snapshot {
+        std::array<std::uint64_t, metric_counters_count> counters{};
+        std::array<histogram_snapshot, metric_histograms_count> histograms{};
+
+        std::uint64_t get(metric_counter counter) const { return counters[static_cast<size_t>(counter)]; }
+        const histogram_snapshot& get(metric_histogram histogram) const { return histograms[static_cast<size_t>(histogram)]; }
+        std::string to_text() const;
+    };
+
+    inline std::string metrics_snapshot::to_text() const {
+        std::ostringstream os{};
+        for (size_t i{ 0 }; i < metric_counters_count; ++i) {
+            os << metric_name(static_cast<metric_counter>(i)) << ' ' << counters[i] << '\n';
+        }
+        for (size_t i{ 0 }; i < metric_histograms_count; ++i) {
+            const char* name = metric_name(static_cast<metric_histogram>(i));
+            const histogram_snapshot& h = histograms[i];
+            for (double q : { 0.5, 0.9, 0.99, 0.999 }) {
+                os << name << "{quantile=\"" << q << "\"} " << h.percentile(q) << '\n';
+            }
+            os << name << "_count " << h.count << '\n';
+            os << name << "_sum " << h.sum << '\n';
+        }
+        return os.str();
+    }
+
+    // Counters and histograms written by one thread only. Plain relaxed load/store pairs
+    // are enough for the owner and let readers merge a consistent-enough view without locks.
+    class metrics_shard {
+    public:
+        void increment(metric_counter counter, std::uint64_t value = 1) {
+            bump(m_counters[static_cast<size_t>(counter)], value);
+        }
+
+        void record(metric_histogram histogram, std::uint64_t value) {
+            size_t h = static_cast<size_t>(histogram);
+            bump(m_buckets[h][log_linear_buckets::index(value)], 1);
+            bump(m_sums[h], value);
+        }
+
+        void merge_into(metrics_snapshot& snapshot) const {
+            for (size_t i{ 0 }; i < metric_counters_count; ++i) {
+                snapshot.counters[i] += m_counters[i].load(std::memory_order_relaxed);
+            }
+            for (size_t h{ 0 }; h < metric_histograms_count; ++h) {
+                histogram_snapshot& target = snapshot.histograms[h];
+                for (size_t b{ 0 }; b < log_linear_buckets::count; ++b) {
+                    std::uint64_t n = m_buckets[h][b].load(std::memory_order_relaxed);
+                    target.buckets[b] += n;
+                    target.count += n;
+                }
+                target.sum += m_sums[h].load(std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        std::atomic<std::uint64_t> m_counters[metric_counters_count]{};
+        std::atomic<std::uint64_t> m_buckets[metric_histograms_count][log_linear_buckets::count]{};
+        std::atomic<std::uint64_t> m_sums[metric_histograms_count]{};
+
+        static void bump(std::atomic<std::uint64_t>& cell, std::uint64_t value) {
+            cell.store(cell.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+    };
+
+    class metrics_registry {
+    public:
+        static metrics_registry& instance() {
+            static metrics_registry registry{};
+            return registry;
+        }
+
+        metrics_shard& this_thread_shard();
+        metrics_snapshot snapshot() const;
+
+    private:
+        class shard_handle {
+        public:
+            explicit shard_handle(metrics_registry& registry);
+            ~shard_handle();
+            metrics_shard& shard() { return *m_shard; }
+        private:
+            metrics_registry& m_registry;
+            std::shared_ptr<metrics_shard> m_shard;
+        };
+
+        mutable std::mutex m_mutex{};
+        std::vector<std::shared_ptr<metrics_shard>> m_shards{};
+        metrics_snapshot m_retired{};
+    };
+
+    inline metrics_registry::shard_handle::shard_handle(metrics_registry& registry)
+        : m_registry{ registry }, m_shard{ std::make_shared<metrics_shard>() } {
+        std::lock_guard<std::mutex> lock{ m_registry.m_mutex };
+        m_registry.m_shards.push_back(m_shard);
+    }
+
+    inline metrics_registry::shard_handle::~shard_handle() {
+        std::lock_guard<std::mutex> lock{ m_registry.m_mutex };
+        m_shard->merge_into(m_registry.m_retired);
+        auto& shards = m_registry.m_shards;
+        for (size_t i{ 0 }; i < shards.size(); ++i) {
+            if (shards[i] == m_shard) {
+                shards[i] = shards.back();
+                shards.pop_back();
+                break;
+            }
+        }
+    }
+
+    inline metrics_shard& metrics_registry::this_thread_shard() {
+        thread_local shard_handle handle{ *this };
+        return handle.shard();
+    }
+
+    inline metrics_snapshot metrics_registry::snapshot() const {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        metrics_snapshot snapshot{ m_retired };
+        for (const auto& shard : m_shards) {
+            shard->merge_into(snapshot);
+        }
+        return snapshot;
+    }
+
+#ifdef MASTERMIND_NO_METRICS
+
+    constexpr bool metrics_enabled{ false };
+
+    inline void count_metric(metric_counter, std::uint64_t = 1) {}
+
+    inline void record_metric(metric_histogram, std::uint64_t) {}
+
+    class scoped_latency {
+    public:
+        explicit scoped_latency(metric_histogram) {}
+    };
+
+#else
+
+    constexpr bool metrics_enabled{ true };
+
+    inline void count_metric(metric_counter counter, std::uint64_t value = 1) {
+        metrics_registry::instance().this_thread_shard().increment(counter, value);
+    }
+
+    inline void record_metric(metric_histogram histogram, std::uint64_t value) {
+        metrics_registry::instance().this_thread_shard().record(histogram, value);
+    }
+
+    class scoped_latency {
+    public:
+        explicit scoped_latency(metric_histogram histogram)
+            : m_histogram{ histogram }, m_begin{ std::chrono::steady_clock::now() } {
+        }
+        scoped_latency(const scoped_latency&) = delete;
+        scoped_latency& operator=(const scoped_latency&) = delete;
+        ~scoped_latency() {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_begin);
+            metrics_registry::instance().this_thread_shard().record(m_histogram, static_cast<std::uint64_t>(elapsed.count()));
+        }
+
+    private:
+        metric_histogram m_histogram;
+        std::chrono::steady_clock::time_point m_begin;
+    };
+
+#endif
+
+}
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(MASTERMIND_PERF_COUNTERS) && defined(__linux__)
+#define MASTERMIND_PERF_COUNTERS_ENABLED 1
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#define MASTERMIND_PERF_COUNTERS_ENABLED 0
+#endif
+
+#define MASTERMIND_PERF_CONCAT_IMPL(a, b) a##b
+#define MASTERMIND_PERF_CONCAT(a, b) MASTERMIND_PERF_CONCAT_IMPL(a, b)
+
+// Measures the enclosing scope with hardware counters and accumulates the figures
+// under the given name. Expands to nothing unless MASTERMIND_PERF_COUNTERS is defined.
+#if MASTERMIND_PERF_COUNTERS_ENABLED
+#define MASTERMIND_PERF_SCOPE(name) \
+    static ::mastermind::perf_region MASTERMIND_PERF_CONCAT(mastermind_perf_region_, __LINE__){ name }; \
+    ::mastermind::perf_scope MASTERMIND_PERF_CONCAT(mastermind_perf_scope_, __LINE__){ MASTERMIND_PERF_CONCAT(mastermind_perf_region_, __LINE__) }
+#else
+#define MASTERMIND_PERF_SCOPE(name) static_cast<void>(0)
+#endif
+
+
+namespace mastermind {
+
+    constexpr bool perf_counters_enabled{ MASTERMIND_PERF_COUNTERS_ENABLED != 0 };
+
+    struct perf_counter_values {
+        std::uint64_t cycles{ 0 };
+        std::uint64_t instructions{ 0 };
+        std::uint64_t cache_misses{ 0 };
+        std::uint64_t branch_misses{ 0 };
+
+        perf_counter_values& operator+=(const perf_counter_values& other) {
+            cycles += other.cycles;
+            instructions += other.instructions;
+            cache_misses += other.cache_misses;
+            branch_misses += other.branch_misses;
+            return *this;
+        }
+    };
+
+    inline perf_counter_values operator-(const perf_counter_values& end, const perf_counter_values& begin) {
+        return { end.cycles - begin.cycles, end.instructions - begin.instructions,
+            end.cache_misses - begin.cache_misses, end.branch_misses - begin.branch_misses };
+    }
+
+    struct perf_region_stats {
+        std::string name;
+        std::uint64_t calls;
+        perf_counter_values totals;
+    };
+
+    inline void write_perf_report(std::ostream& os, const std::vector<perf_region_stats>& stats) {
+        os << "region calls cycles/op instructions/op ipc cache_misses/op branch_misses/op\n";
+        for (const perf_region_stats& s : stats) {
+            double calls = static_cast<double>((std::max)(s.calls, std::uint64_t{ 1 }));
+            double ipc = (s.totals.cycles == 0) ? 0.0 : static_cast<double>(s.totals.instructions) / static_cast<double>(s.totals.cycles);
+            os << s.name << ' ' << s.calls
+                << ' ' << static_cast<double>(s.totals.cycles) / calls
+                << ' ' << static_cast<double>(s.totals.instructions) / calls
+                << ' ' << ipc
+                << ' ' << static_cast<double>(s.totals.cache_misses) / calls
+                << ' ' << static_cast<double>(s.totals.branch_misses) / calls << '\n';
+        }
+    }
+
+#if MASTERMIND_PERF_COUNTERS_ENABLED
+
+    // Counters of the calling thread, opened once per thread as a single perf_event group
+    // so that all four values are read with one syscall. Counters the kernel or the
+    // hardware refuses are reported as zero.
+    class perf_counter_group {
+    public:
+        perf_counter_group();
+        perf_counter_group(const perf_counter_group&) = delete;
+        perf_counter_group& operator=(const perf_counter_group&) = delete;
+        ~perf_counter_group();
+
+        bool is_available() const { return m_leader >= 0; }
+        perf_counter_values read() const;
+
+        static perf_counter_group& this_thread();
+
+    private:
+        static constexpr size_t counters_count{ 4 };
+
+        int m_leader{ -1 };
+        int m_fds[counters_count]{ -1, -1, -1, -1 };
+        size_t m_slots[counters_count]{ 0, 0, 0, 0 };
+        size_t m_opened{ 0 };
+
+        static int open_counter(std::uint64_t config, int group_fd);
+    };
+
+    inline perf_counter_group::perf_counter_group() {
+        const std::uint64_t configs[counters_count]{ PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+
+        for (size_t i{ 0 }; i < counters_count; ++i) {
+            m_fds[i] = open_counter(configs[i], m_leader);
+            if (m_fds[i] >= 0) {
+                if (m_leader < 0) {
+                    m_leader = m_fds[i];
+                }
+                m_slots[i] = m_opened++;
+            }
+        }
+    }
+
+    inline perf_counter_group::~perf_counter_group() {
+        for (int fd : m_fds) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    inline int perf_counter_group::open_counter(std::uint64_t config, int group_fd) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+    }
+
+    inline perf_counter_values perf_counter_group::read() const {
+        perf_counter_values values{};
+        if (m_leader < 0) {
+            return values;
+        }
+
+        std::uint64_t buffer[1 + counters_count]{};
+        if (::read(m_leader, buffer, sizeof(buffer)) <= 0) {
+            return values;
+        }
+
+        std::uint64_t* fields[counters_count]{ &values.cycles, &values.instructions, &values.cache_misses, &values.branch_misses };
+        for (size_t i{ 0 }; i < counters_count; ++i) {
+            if (m_fds[i] >= 0) {
+                *fields[i] = buffer[1 + m_slots[i]];
+            }
+        }
+        return values;
+    }
+
+    inline perf_counter_group& perf_counter_group::this_thread() {
+        thread_local perf_counter_group group{};
+        return group;
+    }
+
+    class perf_region;
+
+    class perf_registry {
+    public:
+        static perf_registry& instance() {
+            static perf_registry registry{};
+            return registry;
+        }
+
+        void add(perf_region* region) {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            m_regions.push_back(region);
+        }
+
+        std::vector<perf_region_stats> snapshot() const;
+        void reset();
+        void report(std::ostream& os) const { write_perf_report(os, snapshot()); }
+
+    private:
+        mutable std::mutex m_mutex{};
+        std::vector<perf_region*> m_regions{};
+    };
+
+    class perf_region {
+    public:
+        explicit perf_region(const char* name) : m_name{ name } {
+            perf_registry::instance().add(this);
+        }
+
+        void add(const perf_counter_values& delta) {
+            m_calls.fetch_add(1, std::memory_order_relaxed);
+            m_cycles.fetch_add(delta.cycles, std::memory_order_relaxed);
+            m_instructions.fetch_add(delta.instructions, std::memory_order_relaxed);
+            m_cache_misses.fetch_add(delta.cache_misses, std::memory_order_relaxed);
+            m_branch_misses.fetch_add(delta.branch_misses, std::memory_order_relaxed);
+        }
+
+        perf_region_stats stats() const {
+            return { m_name, m_calls.load(std::memory_order_relaxed), { m_cycles.load(std::memory_order_relaxed),
+                m_instructions.load(std::memory_order_relaxed), m_cache_misses.load(std::memory_order_relaxed),
+                m_branch_misses.load(std::memory_order_relaxed) } };
+        }
+
+        void reset() {
+            m_calls = 0;
+            m_cycles = 0;
+            m_instructions = 0;
+            m_cache_misses = 0;
+            m_branch_misses = 0;
+        }
+
+    private:
+        const char* m_name;
+        std::atomic<std::uint64_t> m_calls{ 0 };
+        std::atomic<std::uint64_t> m_cycles{ 0 };
+        std::atomic<std::uint64_t> m_instructions{ 0 };
+        std::atomic<std::uint64_t> m_cache_misses{ 0 };
+        std::atomic<std::uint64_t> m_branch_misses{ 0 };
+    };
+
+    inline std::vector<perf_region_stats> perf_registry::snapshot() const {
+        std::map<std::string, perf_region_stats> merged{};
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            for (const perf_region* region : m_regions) {
+                perf_region_stats s = region->stats();
+                auto it = merged.emplace(s.name, perf_region_stats{ s.name, 0, {} }).first;
+                it->second.calls += s.calls;
+                it->second.totals += s.totals;
+            }
+        }
+
+        std::vector<perf_region_stats> stats{};
+        for (auto& entry : merged) {
+            stats.push_back(std::move(entry.second));
+        }
+        return stats;
+    }
+
+    inline void perf_registry::reset() {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        for (perf_region* region : m_regions) {
+            region->reset();
+        }
+    }
+
+    class perf_scope {
+    public:
+        explicit perf_scope(perf_region& region)
+            : m_region{ region }, m_begin{ perf_counter_group::this_thread().read() } {
+        }
+        perf_scope(const perf_scope&) = delete;
+        perf_scope& operator=(const perf_scope&) = delete;
+        ~perf_scope() {
+            m_region.add(perf_counter_group::this_thread().read() - m_begin);
+        }
+
+    private:
+        perf_region& m_region;
+        perf_counter_values m_begin;
+    };
+
+#else
+
+    class perf_counter_group {
+    public:
+        bool is_available() const { return false; }
+        perf_counter_values read() const { return {}; }
+        static perf_counter_group& this_thread() {
+            static perf_counter_group group{};
+            return group;
+        }
+    };
+
+    class perf_registry {
+    public:
+        static perf_registry& instance() {
+            static perf_registry registry{};
+            return registry;
+        }
+        std::vector<perf_region_stats> snapshot() const { return {}; }
+        void reset() {}
+        void report(std::ostream&) const {}
+    };
+
+#endif
+
+}
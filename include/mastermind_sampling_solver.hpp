@@ -0,0 +1,290 @@
+#pragma once
+
+#include "mastermind_consistency_engine.hpp"
+#include "mastermind_exceptions.hpp"
+#include "mastermind_perf_counters.hpp"
+#include "mastermind_utils.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+
+namespace mastermind {
+
+    // Solver for code spaces too big to enumerate. It keeps at most max_sample_size
+    // codes consistent with the feedback seen so far, refills the sample by repairing
+    // random or mutated codes with a bounded local search and scores guesses against
+    // the sample only, so memory and per-move work do not depend on the board size.
+    // When local repair finds nothing, a node-limited constraint search seeds the sample.
+    template<typename Item>
+    class sampling_solver {
+    public:
+        typedef Item value_type;
+
+        sampling_solver(const std::vector<Item>& code_set, game_start_params start_params,
+            size_t max_sample_size = 256, std::uint_fast32_t seed = std::random_device{}());
+
+        std::vector<Item> next_guess();
+        void add_feedback(const std::vector<Item>& guess, game_result result);
+        bool is_consistent(const std::vector<Item>& code) const;
+
+        size_t get_sample_size() const { return m_sample.size(); }
+        size_t get_max_sample_size() const { return m_max_sample_size; }
+        void set_max_repair_steps(size_t steps) { m_max_repair_steps = steps; }
+        void set_search_node_limit(size_t node_limit);
+
+    private:
+        typedef std::vector<size_t> code_type;
+
+        struct feedback {
+            code_type guess;
+            game_result result;
+        };
+
+        std::vector<Item> m_code_set;
+        size_t m_code_size;
+        size_t m_max_sample_size;
+        size_t m_max_repair_steps;
+        size_t m_attempts_per_slot{ 4 };
+        std::vector<feedback> m_history{};
+        std::vector<code_type> m_sample{};
+        std::mt19937 m_generator;
+        std::optional<consistency_engine<size_t>> m_consistency{};
+
+        code_type to_indices(const std::vector<Item>& code) const;
+        std::vector<Item> to_items(const code_type& code) const;
+        size_t distance_from_consistency(const code_type& code) const;
+        code_type random_code();
+        void mutate(code_type& code);
+        bool repair(code_type& code);
+        void refill_sample();
+        const code_type& best_scored_candidate() const;
+    };
+
+    template<typename Item>
+    sampling_solver<Item>::sampling_solver(const std::vector<Item>& code_set, game_start_params start_params,
+        size_t max_sample_size, std::uint_fast32_t seed)
+        : m_code_set{ code_set }, m_code_size{ start_params.code_size }, m_max_sample_size{ std::max<size_t>(max_sample_size, 1) },
+        m_max_repair_steps{ 64 * start_params.code_size }, m_generator{ static_cast<std::mt19937::result_type>(seed) } {
+        if (m_code_size > m_code_set.size()) {
+            throw code_set_too_small_error{ m_code_size, m_code_set.size() };
+        }
+        if (!are_all_values_different(m_code_set)) {
+            throw indistinct_values_error();
+        }
+
+        if (m_code_set.size() <= consistency_engine<size_t>::max_code_set_size) {
+            code_type colors(m_code_set.size());
+            for (size_t i{ 0 }; i < colors.size(); ++i) {
+                colors[i] = i;
+            }
+            m_consistency.emplace(colors, start_params);
+            m_consistency->set_node_limit(64 * m_max_sample_size * m_code_size);
+        }
+    }
+
+    template<typename Item>
+    void sampling_solver<Item>::set_search_node_limit(size_t node_limit) {
+        if (m_consistency) {
+            m_consistency->set_node_limit(node_limit);
+        }
+    }
+
+    template<typename Item>
+    std::vector<Item> sampling_solver<Item>::next_guess() {
+        if (m_sample.empty()) {
+            refill_sample();
+        }
+
+        if (m_sample.empty()) {
+            return to_items(random_code());
+        }
+
+        return to_items(best_scored_candidate());
+    }
+
+    template<typename Item>
+    void sampling_solver<Item>::add_feedback(const std::vector<Item>& guess, game_result result) {
+        if (guess.size() != m_code_size) {
+            throw incorrect_code_size_error{ guess.size(), m_code_size };
+        }
+
+        m_history.push_back({ to_indices(guess), result });
+
+        const feedback& latest = m_history.back();
+        if (m_consistency) {
+            m_consistency->add_feedback(latest.guess, latest.result);
+        }
+        m_sample.erase(std::remove_if(m_sample.begin(), m_sample.end(), [&latest](const code_type& code) {
+            game_result r = compute_game_result(code, latest.guess);
+            return r.pegs_in_right_place != latest.result.pegs_in_right_place
+                || r.pegs_in_right_color != latest.result.pegs_in_right_color;
+        }), m_sample.end());
+
+        refill_sample();
+    }
+
+    template<typename Item>
+    bool sampling_solver<Item>::is_consistent(const std::vector<Item>& code) const {
+        return code.size() == m_code_size && distance_from_consistency(to_indices(code)) == 0;
+    }
+
+    template<typename Item>
+    typename sampling_solver<Item>::code_type sampling_solver<Item>::to_indices(const std::vector<Item>& code) const {
+        code_type indices{};
+        indices.reserve(code.size());
+        for (const Item& value : code) {
+            auto it = std::find(m_code_set.begin(), m_code_set.end(), value);
+            if (it == m_code_set.end()) {
+                throw value_not_in_code_set_error();
+            }
+            indices.push_back(static_cast<size_t>(it - m_code_set.begin()));
+        }
+        return indices;
+    }
+
+    template<typename Item>
+    std::vector<Item> sampling_solver<Item>::to_items(const code_type& code) const {
+        std::vector<Item> items{};
+        items.reserve(code.size());
+        for (size_t index : code) {
+            items.push_back(m_code_set[index]);
+        }
+        return items;
+    }
+
+    template<typename Item>
+    size_t sampling_solver<Item>::distance_from_consistency(const code_type& code) const {
+        size_t distance{ 0 };
+        for (const feedback& f : m_history) {
+            game_result r = compute_game_result(code, f.guess);
+            distance += (std::max)(r.pegs_in_right_place, f.result.pegs_in_right_place) - (std::min)(r.pegs_in_right_place, f.result.pegs_in_right_place);
+            distance += (std::max)(r.pegs_in_right_color, f.result.pegs_in_right_color) - (std::min)(r.pegs_in_right_color, f.result.pegs_in_right_color);
+        }
+        return distance;
+    }
+
+    template<typename Item>
+    typename sampling_solver<Item>::code_type sampling_solver<Item>::random_code() {
+        code_type colors(m_code_set.size());
+        for (size_t i{ 0 }; i < colors.size(); ++i) {
+            colors[i] = i;
+        }
+        for (size_t i{ 0 }; i < m_code_size; ++i) {
+            std::uniform_int_distribution<size_t> pick{ i, colors.size() - 1 };
+            std::swap(colors[i], colors[pick(m_generator)]);
+        }
+        colors.resize(m_code_size);
+        return colors;
+    }
+
+    template<typename Item>
+    void sampling_solver<Item>::mutate(code_type& code) {
+        if (code.empty()) {
+            return;
+        }
+
+        std::uniform_int_distribution<size_t> position{ 0, code.size() - 1 };
+        bool can_swap = code.size() > 1;
+        bool can_replace = m_code_set.size() > code.size();
+
+        if (can_swap && (!can_replace || std::bernoulli_distribution{ 0.5 }(m_generator))) {
+            size_t i = position(m_generator);
+            size_t j = position(m_generator);
+            while (j == i) {
+                j = position(m_generator);
+            }
+            std::swap(code[i], code[j]);
+        }
+        else if (can_replace) {
+            std::vector<bool> used(m_code_set.size(), false);
+            for (size_t index : code) {
+                used[index] = true;
+            }
+            std::uniform_int_distribution<size_t> unused_rank{ 0, m_code_set.size() - code.size() - 1 };
+            size_t rank = unused_rank(m_generator);
+            size_t color{ 0 };
+            for (; used[color] || rank > 0; ++color) {
+                if (!used[color]) {
+                    --rank;
+                }
+            }
+            code[position(m_generator)] = color;
+        }
+    }
+
+    template<typename Item>
+    bool sampling_solver<Item>::repair(code_type& code) {
+        size_t distance = distance_from_consistency(code);
+        for (size_t step{ 0 }; distance > 0 && step < m_max_repair_steps; ++step) {
+            code_type candidate{ code };
+            mutate(candidate);
+            size_t candidate_distance = distance_from_consistency(candidate);
+            if (candidate_distance <= distance) {
+                code = std::move(candidate);
+                distance = candidate_distance;
+            }
+        }
+        return distance == 0;
+    }
+
+    template<typename Item>
+    void sampling_solver<Item>::refill_sample() {
+        MASTERMIND_PERF_SCOPE("sampling_solver.refill_sample");
+        size_t attempts = (m_max_sample_size - m_sample.size()) * m_attempts_per_slot;
+        size_t survivors = m_sample.size();
+
+        for (size_t attempt{ 0 }; attempt < attempts && m_sample.size() < m_max_sample_size; ++attempt) {
+            code_type code{};
+            if (survivors > 0 && std::bernoulli_distribution{ 0.5 }(m_generator)) {
+                code = m_sample[std::uniform_int_distribution<size_t>{ 0, survivors - 1 }(m_generator)];
+                mutate(code);
+            }
+            else {
+                code = random_code();
+            }
+
+            if (repair(code) && std::find(m_sample.begin(), m_sample.end(), code) == m_sample.end()) {
+                m_sample.push_back(std::move(code));
+            }
+        }
+
+        if (m_sample.empty() && m_consistency) {
+            std::optional<code_type> code = m_consistency->find_consistent(m_generator);
+            if (code) {
+                m_sample.push_back(std::move(code.value()));
+            }
+        }
+    }
+
+    template<typename Item>
+    const typename sampling_solver<Item>::code_type& sampling_solver<Item>::best_scored_candidate() const {
+        MASTERMIND_PERF_SCOPE("sampling_solver.score_candidates");
+        const size_t outcomes = (m_code_size + 1) * (m_code_size + 1);
+        std::vector<size_t> partition(outcomes);
+        size_t best_index{ 0 };
+        size_t best_score{ SIZE_MAX };
+
+        for (size_t i{ 0 }; i < m_sample.size() && m_sample.size() > 1; ++i) {
+            std::fill(partition.begin(), partition.end(), 0);
+            for (const code_type& secret : m_sample) {
+                game_result r = compute_game_result(secret, m_sample[i]);
+                ++partition[r.pegs_in_right_place * (m_code_size + 1) + r.pegs_in_right_color];
+            }
+
+            size_t score{ 0 };
+            for (size_t count : partition) {
+                score += count * count;
+            }
+            if (score < best_score) {
+                best_score = score;
+                best_index = i;
+            }
+        }
+
+        return m_sample[best_index];
+    }
+
+}
@@ -0,0 +1,336 @@
+#pragma once
+
+#include "mastermind_exceptions.hpp"
+#include "mastermind_file_utils.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+namespace mastermind {
+
+    // Progress of one shard: the ranks [first, last) of a code space, the next rank to
+    // analyse and the accumulators summed over [first, next). Files are little-endian
+    // regardless of the host and end with a checksum, so they can be copied between
+    // machines and a torn write is detected instead of resumed.
+    struct shard_checkpoint {
+        std::uint64_t job_key{ 0 };
+        std::uint64_t space_size{ 0 };
+        std::uint32_t shard{ 0 };
+        std::uint32_t shard_count{ 0 };
+        std::uint64_t first{ 0 };
+        std::uint64_t last{ 0 };
+        std::uint64_t next{ 0 };
+        std::vector<std::uint64_t> accumulators{};
+
+        bool is_complete() const { return next == last; }
+
+        std::string serialize() const;
+        static shard_checkpoint parse(const std::string& bytes);
+    };
+
+    constexpr char shard_checkpoint_magic[8]{ 'M', 'M', 'S', 'H', 'A', 'R', 'D', 'S' };
+    constexpr std::uint32_t shard_checkpoint_version{ 1 };
+
+    inline std::uint64_t shard_checksum(const char* data, size_t size) {
+        std::uint64_t hash{ 14695981039346656037ULL };
+        for (size_t i{ 0 }; i < size; ++i) {
+            hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    inline std::string shard_checkpoint::serialize() const {
+        std::string bytes(shard_checkpoint_magic, sizeof(shard_checkpoint_magic));
+        auto put = [&bytes](std::uint64_t value, size_t width) {
+            for (size_t i{ 0 }; i < width; ++i) {
+                bytes.push_back(static_cast<char>(value >> (8 * i) & 0xFF));
+            }
+        };
+
+        put(shard_checkpoint_version, 4);
+        put(accumulators.size(), 4);
+        put(job_key, 8);
+        put(space_size, 8);
+        put(shard, 4);
+        put(shard_count, 4);
+        put(first, 8);
+        put(last, 8);
+        put(next, 8);
+        for (std::uint64_t value : accumulators) {
+            put(value, 8);
+        }
+        put(shard_checksum(bytes.data(), bytes.size()), 8);
+        return bytes;
+    }
+
+    inline shard_checkpoint shard_checkpoint::parse(const std::string& bytes) {
+        const size_t fixed_size{ sizeof(shard_checkpoint_magic) + 4 + 4 + 8 + 8 + 4 + 4 + 8 + 8 + 8 };
+        if (bytes.size() < fixed_size + 8 || std::memcmp(bytes.data(), shard_checkpoint_magic, sizeof(shard_checkpoint_magic)) != 0) {
+            throw shard_runner_error{ "not a shard checkpoint" };
+        }
+
+        size_t position{ sizeof(shard_checkpoint_magic) };
+        auto get = [&bytes, &position](size_t width) {
+            std::uint64_t value{ 0 };
+            for (size_t i{ 0 }; i < width; ++i) {
+                value |= std::uint64_t{ static_cast<unsigned char>(bytes[position++]) } << (8 * i);
+            }
+            return value;
+        };
+
+        shard_checkpoint checkpoint{};
+        if (get(4) != shard_checkpoint_version) {
+            throw shard_runner_error{ "unsupported shard checkpoint version" };
+        }
+        const std::uint64_t width = get(4);
+        if (bytes.size() != fixed_size + 8 * width + 8) {
+            throw shard_runner_error{ "truncated shard checkpoint" };
+        }
+        checkpoint.job_key = get(8);
+        checkpoint.space_size = get(8);
+        checkpoint.shard = static_cast<std::uint32_t>(get(4));
+        checkpoint.shard_count = static_cast<std::uint32_t>(get(4));
+        checkpoint.first = get(8);
+        checkpoint.last = get(8);
+        checkpoint.next = get(8);
+        checkpoint.accumulators.resize(static_cast<size_t>(width));
+        for (std::uint64_t& value : checkpoint.accumulators) {
+            value = get(8);
+        }
+
+        if (get(8) != shard_checksum(bytes.data(), bytes.size() - 8)) {
+            throw shard_runner_error{ "shard checkpoint checksum mismatch" };
+        }
+        if (checkpoint.first > checkpoint.next || checkpoint.next > checkpoint.last) {
+            throw shard_runner_error{ "shard checkpoint progress out of range" };
+        }
+        return checkpoint;
+    }
+
+    struct shard_runner_options {
+        size_t shards{ 64 };
+        size_t workers{ 4 };
+        std::uint64_t checkpoint_interval{ 4096 };
+    };
+
+    // Runs an analysis over the ranks [0, space_size) split into contiguous shards, one
+    // forked worker process per shard and at most options.workers at a time. The
+    // analysis is called as analysis(first, last, accumulators) and adds into a fixed
+    // number of 64-bit accumulators; after every checkpoint_interval ranks the shard's
+    // progress is written to <directory>/shard-<n>.ckpt, so a killed run picks up where
+    // its checkpoints stopped. Partial results are summed in shard order.
+    class shard_runner {
+    public:
+        typedef std::uint64_t rank_type;
+
+        shard_runner(std::string directory, std::uint64_t job_key, rank_type space_size, size_t width, shard_runner_options options = {});
+
+        template<typename Analysis>
+        std::vector<std::uint64_t> run(Analysis analysis);
+
+        std::vector<std::uint64_t> merge() const;
+        shard_checkpoint load(size_t shard) const;
+        size_t get_shard_count() const { return m_options.shards; }
+        std::string get_path(size_t shard) const { return m_directory + "/shard-" + std::to_string(shard) + ".ckpt"; }
+
+    private:
+        std::string m_directory;
+        std::uint64_t m_job_key;
+        rank_type m_space_size;
+        size_t m_width;
+        shard_runner_options m_options;
+
+        shard_checkpoint initial(size_t shard) const;
+        std::optional<shard_checkpoint> read(size_t shard) const;
+        void write(const shard_checkpoint& checkpoint) const;
+
+        template<typename Analysis>
+        void run_shard(shard_checkpoint checkpoint, Analysis& analysis) const;
+    };
+
+    inline shard_runner::shard_runner(std::string directory, std::uint64_t job_key, rank_type space_size, size_t width, shard_runner_options options)
+        : m_directory{ std::move(directory) }, m_job_key{ job_key }, m_space_size{ space_size }, m_width{ width }, m_options{ options } {
+        m_options.shards = std::max<size_t>(1, std::min<rank_type>(m_options.shards, std::max<rank_type>(m_space_size, 1)));
+        m_options.workers = std::max<size_t>(m_options.workers, 1);
+        m_options.checkpoint_interval = std::max<std::uint64_t>(m_options.checkpoint_interval, 1);
+        if (::mkdir(m_directory.c_str(), 0755) != 0 && errno != EEXIST) {
+            throw shard_runner_error{ "cannot create " + m_directory + ": " + std::strerror(errno) };
+        }
+    }
+
+    template<typename Analysis>
+    std::vector<std::uint64_t> shard_runner::run(Analysis analysis) {
+        std::vector<shard_checkpoint> pending{};
+        for (size_t shard{ 0 }; shard < m_options.shards; ++shard) {
+            shard_checkpoint checkpoint = load(shard);
+            if (!checkpoint.is_complete()) {
+                pending.push_back(std::move(checkpoint));
+            }
+        }
+
+        std::fflush(nullptr);
+        size_t failures{ 0 };
+        std::vector<pid_t> running{};
+        // Waits for one of the runner's own workers; children forked elsewhere in the
+        // process are left to their owners.
+        auto reap = [&]() {
+            while (true) {
+                for (auto it = running.begin(); it != running.end(); ++it) {
+                    int status{ 0 };
+                    pid_t child = ::waitpid(*it, &status, WNOHANG);
+                    if (child == *it) {
+                        running.erase(it);
+                        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                            ++failures;
+                        }
+                        return;
+                    }
+                    if (child < 0 && errno != EINTR) {
+                        throw shard_runner_error{ std::string{ "wait failed: " } + std::strerror(errno) };
+                    }
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+            }
+        };
+
+        try {
+            for (shard_checkpoint& checkpoint : pending) {
+                while (running.size() >= m_options.workers) {
+                    reap();
+                }
+                pid_t child = ::fork();
+                if (child < 0) {
+                    while (!running.empty()) {
+                        reap();
+                    }
+                    throw shard_runner_error{ std::string{ "fork failed: " } + std::strerror(errno) };
+                }
+                if (child == 0) {
+                    try {
+                        run_shard(std::move(checkpoint), analysis);
+                        ::_exit(0);
+                    }
+                    catch (...) {
+                        ::_exit(1);
+                    }
+                }
+                running.push_back(child);
+            }
+            while (!running.empty()) {
+                reap();
+            }
+        }
+        catch (...) {
+            for (pid_t child : running) {
+                ::kill(child, SIGKILL);
+            }
+            for (pid_t child : running) {
+                while (::waitpid(child, nullptr, 0) < 0 && errno == EINTR) {
+                }
+            }
+            throw;
+        }
+
+        if (failures > 0) {
+            throw shard_runner_error{ std::to_string(failures) + " worker(s) failed, rerun to resume from the checkpoints" };
+        }
+        return merge();
+    }
+
+    template<typename Analysis>
+    void shard_runner::run_shard(shard_checkpoint checkpoint, Analysis& analysis) const {
+        while (!checkpoint.is_complete()) {
+            rank_type last = checkpoint.next + std::min(m_options.checkpoint_interval, checkpoint.last - checkpoint.next);
+            analysis(checkpoint.next, last, checkpoint.accumulators.data());
+            checkpoint.next = last;
+            write(checkpoint);
+        }
+    }
+
+    inline std::vector<std::uint64_t> shard_runner::merge() const {
+        std::vector<std::uint64_t> totals(m_width, 0);
+        for (size_t shard{ 0 }; shard < m_options.shards; ++shard) {
+            shard_checkpoint checkpoint = load(shard);
+            if (!checkpoint.is_complete()) {
+                throw shard_runner_error{ "shard " + std::to_string(shard) + " is not complete" };
+            }
+            for (size_t i{ 0 }; i < m_width; ++i) {
+                totals[i] += checkpoint.accumulators[i];
+            }
+        }
+        return totals;
+    }
+
+    inline shard_checkpoint shard_runner::load(size_t shard) const {
+        std::optional<shard_checkpoint> checkpoint = read(shard);
+        if (!checkpoint) {
+            return initial(shard);
+        }
+
+        shard_checkpoint expected = initial(shard);
+        if (checkpoint->job_key != expected.job_key || checkpoint->space_size != expected.space_size
+            || checkpoint->shard != expected.shard || checkpoint->shard_count != expected.shard_count
+            || checkpoint->first != expected.first || checkpoint->last != expected.last
+            || checkpoint->accumulators.size() != m_width) {
+            throw shard_runner_error{ get_path(shard) + " belongs to a different job" };
+        }
+        return std::move(checkpoint.value());
+    }
+
+    inline shard_checkpoint shard_runner::initial(size_t shard) const {
+        shard_checkpoint checkpoint{};
+        checkpoint.job_key = m_job_key;
+        checkpoint.space_size = m_space_size;
+        checkpoint.shard = static_cast<std::uint32_t>(shard);
+        checkpoint.shard_count = static_cast<std::uint32_t>(m_options.shards);
+        checkpoint.first = m_space_size / m_options.shards * shard + std::min<rank_type>(shard, m_space_size % m_options.shards);
+        checkpoint.last = checkpoint.first + m_space_size / m_options.shards + ((shard < m_space_size % m_options.shards) ? 1 : 0);
+        checkpoint.next = checkpoint.first;
+        checkpoint.accumulators.assign(m_width, 0);
+        return checkpoint;
+    }
+
+    inline std::optional<shard_checkpoint> shard_runner::read(size_t shard) const {
+        std::ifstream file{ get_path(shard), std::ios::binary };
+        if (!file) {
+            return std::nullopt;
+        }
+        std::string bytes{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+        try {
+            return shard_checkpoint::parse(bytes);
+        }
+        catch (const shard_runner_error& error) {
+            throw shard_runner_error{ get_path(shard) + ": " + error.what() };
+        }
+    }
+
+    // Writes to a temporary file, syncs it and renames it over the previous checkpoint,
+    // so the file on disk is always either the old or the new checkpoint.
+    inline void shard_runner::write(const shard_checkpoint& checkpoint) const {
+        const std::string path = get_path(checkpoint.shard);
+        const std::string bytes = checkpoint.serialize();
+        try {
+            write_file_atomically(path, bytes.data(), bytes.size());
+        }
+        catch (const std::runtime_error& error) {
+            throw shard_runner_error{ error.what() };
+        }
+    }
+
+}
@@ -0,0 +1,260 @@
+#pragma once
+
+#include "mastermind_exceptions.hpp"
+#include "mastermind_metrics.hpp"
+#include "mastermind_perf_counters.hpp"
+#include "mastermind_utils.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace mastermind {
+
+    // Everything a player of a shared challenge owns.
+    struct challenge_player {
+        std::uint32_t tries_left{ 0 };
+        game_status status{ game_status::NOT_INITIALIZED };
+    };
+
+    // One secret code played by any number of players, e.g. a daily puzzle. The challenge
+    // is immutable after construction, so every member is safe to call from many threads
+    // at once; each thread only writes the challenge_player objects it was given.
+    //
+    // A lookup from value to its position in the secret is built once. For integral
+    // values spanning fewer than 256 numbers it is a dense table indexed by value,
+    // otherwise a sorted list of (value, position) pairs searched per guessed value.
+    template<typename Item>
+    class shared_challenge {
+    public:
+        typedef Item value_type;
+
+        struct check_solution_request {
+            challenge_player* player;
+            const std::vector<Item>* solution;
+            std::optional<game_result> result;
+            std::exception_ptr error;
+        };
+
+        shared_challenge(std::vector<Item> code_pattern, size_t max_tries, code_rule rule = code_rule::DISTINCT_VALUES);
+
+        const std::vector<Item>& get_code_pattern() const { return m_code_pattern; }
+        size_t get_code_size() const { return m_code_pattern.size(); }
+        size_t get_max_tries() const { return m_max_tries; }
+        code_rule get_code_rule() const { return m_rule; }
+
+        challenge_player join() const;
+
+        // Scores guesses of get_code_size() values each, stored back to back. The
+        // guesses must already follow the code rule; nothing is validated.
+        game_result score(const Item* guess) const;
+        void score_guesses(const Item* guesses, size_t count, game_result* results) const;
+
+        // Validates the guess like mastermind_engine::check_solution and charges it to the
+        // player. Returns std::nullopt for players that are not in game.
+        std::optional<game_result> check_solution(challenge_player& player, const std::vector<Item>& s) const;
+        // Same as check_solution on every request in order; errors are stored in the
+        // request instead of thrown.
+        void check_solutions(check_solution_request* requests, size_t count) const;
+
+    private:
+        static constexpr std::int16_t absent{ -1 };
+
+        std::vector<Item> m_code_pattern;
+        std::uint32_t m_max_tries;
+        code_rule m_rule;
+        bool m_dense{ false };
+        Item m_base{};
+        std::vector<std::int16_t> m_positions{};
+        std::vector<std::uint16_t> m_counts{};
+        std::vector<std::pair<Item, size_t>> m_sorted{};
+
+        void validate_solution(const std::vector<Item>& s) const;
+        std::optional<size_t> dense_index(const Item& value) const;
+        game_result score_distinct(const Item* guess) const;
+        game_result score_repeated(const Item* guess) const;
+    };
+
+    template<typename Item>
+    shared_challenge<Item>::shared_challenge(std::vector<Item> code_pattern, size_t max_tries, code_rule rule)
+        : m_code_pattern{ std::move(code_pattern) }, m_max_tries{ static_cast<std::uint32_t>(max_tries) }, m_rule{ rule } {
+        if (max_tries == 0) {
+            throw zero_max_tries_value_error();
+        }
+        if (max_tries > std::numeric_limits<std::uint32_t>::max()) {
+            throw max_tries_too_large_error{ max_tries, std::numeric_limits<std::uint32_t>::max() };
+        }
+        if (m_rule == code_rule::DISTINCT_VALUES && !are_all_values_different(m_code_pattern)) {
+            throw indistinct_values_error();
+        }
+
+        if constexpr (std::is_integral<Item>::value) {
+            if (!m_code_pattern.empty() && m_code_pattern.size() < 256) {
+                const auto bounds = std::minmax_element(m_code_pattern.begin(), m_code_pattern.end());
+                const std::uint64_t span = static_cast<std::uint64_t>(*bounds.second) - static_cast<std::uint64_t>(*bounds.first);
+                if (span < 256) {
+                    m_dense = true;
+                    m_base = *bounds.first;
+                    m_positions.assign(static_cast<size_t>(span) + 1, absent);
+                    m_counts.assign(static_cast<size_t>(span) + 1, 0);
+                    for (size_t i{ 0 }; i < m_code_pattern.size(); ++i) {
+                        const size_t index = static_cast<size_t>(m_code_pattern[i] - m_base);
+                        m_positions[index] = static_cast<std::int16_t>(i);
+                        ++m_counts[index];
+                    }
+                }
+            }
+        }
+
+        if (!m_dense && m_rule == code_rule::DISTINCT_VALUES) {
+            for (size_t i{ 0 }; i < m_code_pattern.size(); ++i) {
+                m_sorted.emplace_back(m_code_pattern[i], i);
+            }
+            std::sort(m_sorted.begin(), m_sorted.end(),
+                [](const std::pair<Item, size_t>& a, const std::pair<Item, size_t>& b) { return a.first < b.first; });
+        }
+    }
+
+    template<typename Item>
+    challenge_player shared_challenge<Item>::join() const {
+        count_metric(metric_counter::GAMES_STARTED);
+        return { m_max_tries, game_status::IN_GAME };
+    }
+
+    template<typename Item>
+    game_result shared_challenge<Item>::score(const Item* guess) const {
+        return (m_rule == code_rule::REPEATED_VALUES) ? score_repeated(guess) : score_distinct(guess);
+    }
+
+    template<typename Item>
+    void shared_challenge<Item>::score_guesses(const Item* guesses, size_t count, game_result* results) const {
+        MASTERMIND_PERF_SCOPE("challenge.score_guesses");
+        const size_t size = m_code_pattern.size();
+        for (size_t k{ 0 }; k < count; ++k) {
+            results[k] = score(guesses + k * size);
+        }
+    }
+
+    template<typename Item>
+    std::optional<game_result> shared_challenge<Item>::check_solution(challenge_player& player, const std::vector<Item>& s) const {
+        validate_solution(s);
+        if (player.status != game_status::IN_GAME) {
+            return std::nullopt;
+        }
+
+        game_result result = score(s.data());
+        count_metric(metric_counter::GUESSES_SCORED);
+        if (result.valid) {
+            player.tries_left = 0;
+            count_metric(metric_counter::GAMES_WON);
+        }
+        else if (--player.tries_left == 0) {
+            count_metric(metric_counter::GAMES_LOST);
+        }
+        if (player.tries_left == 0) {
+            player.status = game_status::ENDED;
+        }
+        return result;
+    }
+
+    template<typename Item>
+    void shared_challenge<Item>::check_solutions(check_solution_request* requests, size_t count) const {
+        MASTERMIND_PERF_SCOPE("challenge.check_solutions");
+        for (size_t i{ 0 }; i < count; ++i) {
+            check_solution_request& request = requests[i];
+            try {
+                request.result = check_solution(*request.player, *request.solution);
+            }
+            catch (...) {
+                request.error = std::current_exception();
+            }
+        }
+    }
+
+    template<typename Item>
+    void shared_challenge<Item>::validate_solution(const std::vector<Item>& s) const {
+        if (s.size() != m_code_pattern.size()) {
+            count_metric(metric_counter::INCORRECT_CODE_SIZE_ERRORS);
+            throw incorrect_code_size_error{ s.size(), m_code_pattern.size() };
+        }
+        if (m_rule == code_rule::DISTINCT_VALUES && !are_all_values_different(s)) {
+            count_metric(metric_counter::INDISTINCT_VALUES_ERRORS);
+            throw indistinct_values_error();
+        }
+    }
+
+    template<typename Item>
+    std::optional<size_t> shared_challenge<Item>::dense_index(const Item& value) const {
+        if constexpr (std::is_integral<Item>::value) {
+            const std::uint64_t offset = static_cast<std::uint64_t>(value) - static_cast<std::uint64_t>(m_base);
+            if (offset < m_positions.size()) {
+                return static_cast<size_t>(offset);
+            }
+        }
+        return std::nullopt;
+    }
+
+    template<typename Item>
+    game_result shared_challenge<Item>::score_distinct(const Item* guess) const {
+        const size_t size = m_code_pattern.size();
+        size_t in_place{ 0 };
+        size_t in_color{ 0 };
+
+        for (size_t i{ 0 }; i < size; ++i) {
+            size_t position{ size };
+            if (m_dense) {
+                auto index = dense_index(guess[i]);
+                if (index && m_positions[*index] != absent) {
+                    position = static_cast<size_t>(m_positions[*index]);
+                }
+            }
+            else {
+                auto it = std::lower_bound(m_sorted.begin(), m_sorted.end(), guess[i],
+                    [](const std::pair<Item, size_t>& entry, const Item& value) { return entry.first < value; });
+                if (it != m_sorted.end() && it->first == guess[i]) {
+                    position = it->second;
+                }
+            }
+
+            if (position == i) {
+                ++in_place;
+            }
+            else if (position != size) {
+                ++in_color;
+            }
+        }
+
+        return game_result{ (in_place == size), in_place, in_color };
+    }
+
+    // Counts common values against the precomputed multiplicities of the secret, using
+    // a per-call tally that only covers the values the secret contains.
+    template<typename Item>
+    game_result shared_challenge<Item>::score_repeated(const Item* guess) const {
+        const size_t size = m_code_pattern.size();
+        if (!m_dense) {
+            return compute_game_result_with_repeats(m_code_pattern.data(), guess, size);
+        }
+
+        std::uint16_t used[256]{};
+        size_t in_place{ 0 };
+        size_t common{ 0 };
+        for (size_t i{ 0 }; i < size; ++i) {
+            in_place += (guess[i] == m_code_pattern[i]) ? 1 : 0;
+            if (auto index = dense_index(guess[i])) {
+                if (used[*index] < m_counts[*index]) {
+                    ++used[*index];
+                    ++common;
+                }
+            }
+        }
+
+        return game_result{ (in_place == size), in_place, common - in_place };
+    }
+
+}
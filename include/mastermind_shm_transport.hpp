@@ -0,0 +1,489 @@
+#pragma once
+
+#include "mastermind_engine.hpp"
+#include "mastermind_exceptions.hpp"
+#include "mastermind_utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace mastermind {
+
+    enum class shm_request_kind : std::uint8_t {
+        START_GAME = 1,
+        GUESS = 2
+    };
+
+    enum class shm_error : std::uint8_t {
+        NONE,
+        UNKNOWN_SESSION,
+        UNKNOWN_REQUEST,
+        INCORRECT_CODE_SIZE,
+        INDISTINCT_VALUES,
+        ZERO_MAX_TRIES,
+        INVALID_REQUEST
+    };
+
+    // Guess values travel as bytes, so sessions use integral values in 0..255.
+    struct shm_request {
+        static constexpr size_t max_code_size{ 20 };
+
+        std::uint32_t session;
+        shm_request_kind kind;
+        std::uint8_t code_size;
+        std::uint16_t reserved;
+        std::uint32_t max_tries;
+        std::uint8_t code[max_code_size];
+    };
+
+    struct shm_response {
+        std::uint32_t session;
+        std::uint32_t tries_left;
+        shm_request_kind kind;
+        shm_error error;
+        std::uint8_t status;
+        std::uint8_t valid;
+        std::uint8_t pegs_in_right_place;
+        std::uint8_t pegs_in_right_color;
+        std::uint16_t reserved;
+    };
+
+    static_assert(sizeof(shm_request) == 32, "shm_request must be 32 bytes");
+    static_assert(sizeof(shm_response) == 16, "shm_response must be 16 bytes");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared rings need lock-free 64-bit atomics");
+
+    inline shm_request make_start_game_request(std::uint32_t session, game_start_params start_params) {
+        if (start_params.code_size > shm_request::max_code_size) {
+            throw shm_transport_error{ "code of " + std::to_string(start_params.code_size) + " values does not fit in a request" };
+        }
+        if (start_params.max_tries > std::numeric_limits<std::uint32_t>::max()) {
+            throw shm_transport_error{ "max tries value " + std::to_string(start_params.max_tries) + " does not fit in a request" };
+        }
+
+        shm_request request{};
+        request.session = session;
+        request.kind = shm_request_kind::START_GAME;
+        request.code_size = static_cast<std::uint8_t>(start_params.code_size);
+        request.max_tries = static_cast<std::uint32_t>(start_params.max_tries);
+        return request;
+    }
+
+    template<typename Item>
+    shm_request make_guess_request(std::uint32_t session, const std::vector<Item>& guess) {
+        static_assert(std::is_integral<Item>::value, "shm_request stores values as bytes");
+        if (guess.size() > shm_request::max_code_size) {
+            throw shm_transport_error{ "guess of " + std::to_string(guess.size()) + " values does not fit in a request" };
+        }
+
+        shm_request request{};
+        request.session = session;
+        request.kind = shm_request_kind::GUESS;
+        request.code_size = static_cast<std::uint8_t>(guess.size());
+        for (size_t i{ 0 }; i < guess.size(); ++i) {
+            bool negative{ false };
+            if constexpr (std::is_signed<Item>::value) {
+                negative = guess[i] < 0;
+            }
+            if (negative || static_cast<std::uint64_t>(guess[i]) > std::numeric_limits<std::uint8_t>::max()) {
+                throw shm_transport_error{ "value " + std::to_string(guess[i]) + " does not fit in a byte" };
+            }
+            request.code[i] = static_cast<std::uint8_t>(guess[i]);
+        }
+        return request;
+    }
+
+    // Control block of a single-producer single-consumer ring living in shared memory.
+    // head and tail only grow; each sits on its own cache line so that the producer and
+    // the consumer never write to the same line.
+    struct shm_ring_header {
+        alignas(64) std::atomic<std::uint64_t> head;
+        alignas(64) std::atomic<std::uint64_t> tail;
+        alignas(64) std::uint64_t capacity;
+    };
+
+    // Process-local view of a ring. The producer keeps a stale copy of the consumer
+    // position and the consumer of the producer position, so the shared counters are
+    // only read when the cached value says the ring is full or empty.
+    template<typename Record>
+    class shm_ring {
+    public:
+        shm_ring() = default;
+        shm_ring(shm_ring_header* header, Record* slots)
+            : m_header{ header }, m_slots{ slots }, m_mask{ header->capacity - 1 } {
+        }
+
+        size_t try_push(const Record* records, size_t count);
+        size_t try_pop(Record* records, size_t count);
+        size_t free_slots();
+
+        bool try_push(const Record& record) { return try_push(&record, 1) == 1; }
+        bool try_pop(Record& record) { return try_pop(&record, 1) == 1; }
+
+    private:
+        shm_ring_header* m_header{ nullptr };
+        Record* m_slots{ nullptr };
+        std::uint64_t m_mask{ 0 };
+        std::uint64_t m_cached_head{ 0 };
+        std::uint64_t m_cached_tail{ 0 };
+    };
+
+    template<typename Record>
+    size_t shm_ring<Record>::free_slots() {
+        const std::uint64_t tail = m_header->tail.load(std::memory_order_relaxed);
+        m_cached_head = m_header->head.load(std::memory_order_acquire);
+        return static_cast<size_t>(m_mask + 1 - (tail - m_cached_head));
+    }
+
+    template<typename Record>
+    size_t shm_ring<Record>::try_push(const Record* records, size_t count) {
+        const std::uint64_t tail = m_header->tail.load(std::memory_order_relaxed);
+        std::uint64_t free = m_mask + 1 - (tail - m_cached_head);
+        if (free < count) {
+            m_cached_head = m_header->head.load(std::memory_order_acquire);
+            free = m_mask + 1 - (tail - m_cached_head);
+        }
+
+        const size_t pushed = static_cast<size_t>(std::min<std::uint64_t>(free, count));
+        for (size_t i{ 0 }; i < pushed; ++i) {
+            m_slots[(tail + i) & m_mask] = records[i];
+        }
+        if (pushed > 0) {
+            m_header->tail.store(tail + pushed, std::memory_order_release);
+        }
+        return pushed;
+    }
+
+    template<typename Record>
+    size_t shm_ring<Record>::try_pop(Record* records, size_t count) {
+        const std::uint64_t head = m_header->head.load(std::memory_order_relaxed);
+        std::uint64_t available = m_cached_tail - head;
+        if (available < count) {
+            m_cached_tail = m_header->tail.load(std::memory_order_acquire);
+            available = m_cached_tail - head;
+        }
+
+        const size_t popped = static_cast<size_t>(std::min<std::uint64_t>(available, count));
+        for (size_t i{ 0 }; i < popped; ++i) {
+            records[i] = m_slots[(head + i) & m_mask];
+        }
+        if (popped > 0) {
+            m_header->head.store(head + popped, std::memory_order_release);
+        }
+        return popped;
+    }
+
+    // POSIX shared-memory segment holding a request ring (bot to engine) and a response
+    // ring (engine to bot). The creating side owns the name and unlinks it on destruction.
+    class shm_channel {
+    public:
+        static constexpr size_t default_capacity{ 1024 };
+
+        shm_channel(const std::string& name, size_t capacity);
+        explicit shm_channel(const std::string& name);
+        shm_channel(const shm_channel&) = delete;
+        shm_channel& operator=(const shm_channel&) = delete;
+        ~shm_channel();
+
+        shm_ring<shm_request>& requests() { return m_requests; }
+        shm_ring<shm_response>& responses() { return m_responses; }
+        size_t get_capacity() const { return m_capacity; }
+
+    private:
+        struct segment_header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t record_sizes;
+            std::uint64_t capacity;
+        };
+
+        static constexpr char magic[8]{ 'M', 'M', 'S', 'H', 'M', 'B', 'O', 'T' };
+        static constexpr std::uint32_t version{ 1 };
+        static constexpr std::uint32_t record_sizes{ sizeof(shm_request) << 16 | sizeof(shm_response) };
+
+        std::string m_name;
+        bool m_owner;
+        void* m_data{ nullptr };
+        size_t m_length{ 0 };
+        size_t m_capacity{ 0 };
+        shm_ring<shm_request> m_requests{};
+        shm_ring<shm_response> m_responses{};
+
+        static size_t align(size_t size) { return (size + 63) / 64 * 64; }
+        static size_t segment_size(size_t capacity);
+        void map(int fd, size_t length);
+        void attach_rings();
+    };
+
+    inline size_t shm_channel::segment_size(size_t capacity) {
+        return align(sizeof(segment_header)) + 2 * align(sizeof(shm_ring_header))
+            + align(capacity * sizeof(shm_request)) + align(capacity * sizeof(shm_response));
+    }
+
+    inline shm_channel::shm_channel(const std::string& name, size_t capacity)
+        : m_name{ name }, m_owner{ true }, m_capacity{ capacity } {
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+            throw shm_transport_error{ "ring capacity " + std::to_string(capacity) + " is not a power of two" };
+        }
+
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            throw shm_transport_error{ "cannot create " + name + ": " + std::strerror(errno) };
+        }
+        const size_t length = segment_size(capacity);
+        if (::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+            int error = errno;
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            throw shm_transport_error{ "cannot resize " + name + ": " + std::strerror(error) };
+        }
+        map(fd, length);
+
+        char* base = static_cast<char*>(m_data) + align(sizeof(segment_header));
+        for (int ring{ 0 }; ring < 2; ++ring) {
+            shm_ring_header* header = new (base + ring * align(sizeof(shm_ring_header))) shm_ring_header{};
+            header->capacity = capacity;
+        }
+
+        segment_header header{};
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.version = version;
+        header.record_sizes = record_sizes;
+        header.capacity = capacity;
+        std::memcpy(m_data, &header, sizeof(header));
+        attach_rings();
+    }
+
+    inline shm_channel::shm_channel(const std::string& name)
+        : m_name{ name }, m_owner{ false } {
+        int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+        if (fd < 0) {
+            throw shm_transport_error{ "cannot open " + name + ": " + std::strerror(errno) };
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(segment_header)) {
+            ::close(fd);
+            throw shm_transport_error{ name + " is not a mastermind channel" };
+        }
+        map(fd, static_cast<size_t>(st.st_size));
+
+        segment_header header{};
+        std::memcpy(&header, m_data, sizeof(header));
+        if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version
+            || header.record_sizes != record_sizes || header.capacity < 2 || segment_size(header.capacity) > m_length) {
+            ::munmap(m_data, m_length);
+            throw shm_transport_error{ name + " has an unsupported layout" };
+        }
+        m_capacity = static_cast<size_t>(header.capacity);
+        attach_rings();
+    }
+
+    inline shm_channel::~shm_channel() {
+        ::munmap(m_data, m_length);
+        if (m_owner) {
+            ::shm_unlink(m_name.c_str());
+        }
+    }
+
+    inline void shm_channel::map(int fd, size_t length) {
+        void* data = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        int error = errno;
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            if (m_owner) {
+                ::shm_unlink(m_name.c_str());
+            }
+            throw shm_transport_error{ std::string{ "mmap failed: " } + std::strerror(error) };
+        }
+        m_data = data;
+        m_length = length;
+    }
+
+    inline void shm_channel::attach_rings() {
+        char* base = static_cast<char*>(m_data) + align(sizeof(segment_header));
+        auto* request_header = reinterpret_cast<shm_ring_header*>(base);
+        auto* response_header = reinterpret_cast<shm_ring_header*>(base + align(sizeof(shm_ring_header)));
+        char* slots = base + 2 * align(sizeof(shm_ring_header));
+        m_requests = shm_ring<shm_request>{ request_header, reinterpret_cast<shm_request*>(slots) };
+        m_responses = shm_ring<shm_response>{ response_header, reinterpret_cast<shm_response*>(slots + align(m_capacity * sizeof(shm_request))) };
+    }
+
+    // Plays the engine side of a channel: every request names a session, sessions are
+    // created on first use and are engines sharing one code generator.
+    template<typename Item>
+    class shm_engine_server {
+    public:
+        static_assert(std::is_integral<Item>::value, "shm_request stores values as bytes");
+        typedef typename mastermind_engine<Item>::code_gen_type code_gen_type;
+
+        static constexpr size_t default_max_sessions{ 65536 };
+
+        shm_engine_server(shm_channel& channel, code_gen_type code_pattern_generator, size_t max_sessions = default_max_sessions);
+
+        size_t poll(size_t max_batch = 64);
+        void serve(const std::atomic<bool>& stop);
+
+    private:
+        shm_channel& m_channel;
+        code_gen_type m_code_generator;
+        size_t m_max_sessions;
+        std::vector<std::unique_ptr<mastermind_engine<Item>>> m_sessions{};
+        std::vector<shm_request> m_requests{};
+        std::vector<shm_response> m_responses{};
+        std::vector<Item> m_guess{};
+
+        shm_response handle(const shm_request& request);
+        shm_error execute(const shm_request& request, mastermind_engine<Item>& engine, shm_response& response);
+    };
+
+    template<typename Item>
+    shm_engine_server<Item>::shm_engine_server(shm_channel& channel, code_gen_type code_pattern_generator, size_t max_sessions)
+        : m_channel{ channel }, m_code_generator{ code_pattern_generator }, m_max_sessions{ max_sessions } {
+    }
+
+    // Takes at most as many requests as there is room for responses, so a slow bot
+    // stalls the server instead of losing feedback.
+    template<typename Item>
+    size_t shm_engine_server<Item>::poll(size_t max_batch) {
+        const size_t room = std::min(max_batch, m_channel.responses().free_slots());
+        m_requests.resize(room);
+        const size_t count = m_channel.requests().try_pop(m_requests.data(), room);
+
+        m_responses.clear();
+        for (size_t i{ 0 }; i < count; ++i) {
+            m_responses.push_back(handle(m_requests[i]));
+        }
+        m_channel.responses().try_push(m_responses.data(), m_responses.size());
+        return count;
+    }
+
+    template<typename Item>
+    void shm_engine_server<Item>::serve(const std::atomic<bool>& stop) {
+        size_t idle{ 0 };
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (poll() > 0) {
+                idle = 0;
+            }
+            else if (++idle > 64) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    template<typename Item>
+    shm_response shm_engine_server<Item>::handle(const shm_request& request) {
+        shm_response response{};
+        response.session = request.session;
+        response.kind = request.kind;
+
+        if (request.session >= m_max_sessions) {
+            response.error = shm_error::UNKNOWN_SESSION;
+            return response;
+        }
+        if (request.session >= m_sessions.size()) {
+            m_sessions.resize(request.session + 1);
+        }
+        std::unique_ptr<mastermind_engine<Item>>& engine = m_sessions[request.session];
+        if (!engine) {
+            engine = std::make_unique<mastermind_engine<Item>>(m_code_generator);
+        }
+
+        try {
+            response.error = execute(request, *engine, response);
+        }
+        catch (const incorrect_code_size_error&) {
+            response.error = shm_error::INCORRECT_CODE_SIZE;
+        }
+        catch (const indistinct_values_error&) {
+            response.error = shm_error::INDISTINCT_VALUES;
+        }
+        catch (const zero_max_tries_value_error&) {
+            response.error = shm_error::ZERO_MAX_TRIES;
+        }
+        catch (const std::logic_error&) {
+            response.error = shm_error::INVALID_REQUEST;
+        }
+
+        response.status = static_cast<std::uint8_t>(engine->get_status());
+        response.tries_left = static_cast<std::uint32_t>(std::min<size_t>(engine->get_tries_left(), UINT32_MAX));
+        return response;
+    }
+
+    template<typename Item>
+    shm_error shm_engine_server<Item>::execute(const shm_request& request, mastermind_engine<Item>& engine, shm_response& response) {
+        switch (request.kind) {
+        case shm_request_kind::START_GAME:
+            engine.start_game({ request.code_size, request.max_tries });
+            return shm_error::NONE;
+        case shm_request_kind::GUESS: {
+            if (request.code_size > shm_request::max_code_size) {
+                return shm_error::INVALID_REQUEST;
+            }
+            m_guess.assign(request.code, request.code + request.code_size);
+            std::optional<game_result> result = engine.check_solution(m_guess);
+            if (result) {
+                response.valid = result.value().valid ? 1 : 0;
+                response.pegs_in_right_place = static_cast<std::uint8_t>(result.value().pegs_in_right_place);
+                response.pegs_in_right_color = static_cast<std::uint8_t>(result.value().pegs_in_right_color);
+            }
+            return shm_error::NONE;
+        }
+        default:
+            return shm_error::UNKNOWN_REQUEST;
+        }
+    }
+
+    // Bot side of a channel. Requests may be pipelined with try_send/try_receive;
+    // responses come back in request order.
+    class shm_bot_client {
+    public:
+        explicit shm_bot_client(shm_channel& channel) : m_channel{ channel } {}
+
+        bool try_send(const shm_request& request) { return m_channel.requests().try_push(request); }
+        bool try_receive(shm_response& response) { return m_channel.responses().try_pop(response); }
+
+        shm_response call(const shm_request& request);
+        shm_response start_game(std::uint32_t session, game_start_params start_params) {
+            return call(make_start_game_request(session, start_params));
+        }
+        template<typename Item>
+        shm_response guess(std::uint32_t session, const std::vector<Item>& code) {
+            return call(make_guess_request(session, code));
+        }
+
+    private:
+        shm_channel& m_channel;
+
+        template<typename Operation>
+        static void spin_until(Operation operation) {
+            for (size_t spins{ 0 }; !operation(); ++spins) {
+                if (spins > 64) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    };
+
+    inline shm_response shm_bot_client::call(const shm_request& request) {
+        spin_until([&]() { return try_send(request); });
+        shm_response response{};
+        spin_until([&]() { return try_receive(response); });
+        return response;
+    }
+
+}
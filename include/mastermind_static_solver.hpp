@@ -0,0 +1,302 @@
+#pragma once
+
+#include "mastermind_code_space.hpp"
+#include "mastermind_exceptions.hpp"
+#include "mastermind_perf_counters.hpp"
+#include "mastermind_utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+
+namespace mastermind {
+
+    struct static_solver_options {
+        size_t threads{ std::thread::hardware_concurrency() };
+        size_t max_iterations{ 20000 };
+        std::uint_fast32_t seed{ 0 };
+    };
+
+    // Non-adaptive play: looks for a small set of guesses, all submitted up front, whose
+    // combined feedback tells every secret apart. A greedy set is shrunk one guess at a
+    // time by parallel local search over the feedback_table until the search fails or the
+    // counting lower bound is reached.
+    template<typename Item>
+    class static_solver {
+    public:
+        typedef Item value_type;
+        typedef code_space::rank_type rank_type;
+
+        static_solver(const std::vector<Item>& code_set, game_start_params start_params, static_solver_options options = {});
+
+        std::vector<std::vector<Item>> solve();
+        bool verify(const std::vector<std::vector<Item>>& guesses) const;
+        size_t get_lower_bound() const;
+
+    private:
+        std::vector<Item> m_code_set;
+        code_space m_space;
+        static_solver_options m_options;
+        std::optional<feedback_table> m_table{};
+
+        std::vector<Item> to_items(const std::vector<size_t>& code) const;
+        std::vector<size_t> to_indices(const std::vector<Item>& code) const;
+        size_t count_ambiguous(const std::vector<rank_type>& guesses, std::vector<std::uint32_t>& ids, std::vector<std::uint32_t>& remap) const;
+        std::vector<rank_type> greedy() const;
+        std::optional<std::vector<rank_type>> local_search(size_t size, std::uint_fast32_t seed) const;
+    };
+
+    template<typename Item>
+    static_solver<Item>::static_solver(const std::vector<Item>& code_set, game_start_params start_params, static_solver_options options)
+        : m_code_set{ code_set }, m_space{ code_set.size(), start_params.code_size }, m_options{ options } {
+        if (!are_all_values_different(m_code_set)) {
+            throw indistinct_values_error();
+        }
+        m_options.threads = std::max<size_t>(m_options.threads, 1);
+    }
+
+    template<typename Item>
+    std::vector<std::vector<Item>> static_solver<Item>::solve() {
+        if (!m_table) {
+            MASTERMIND_PERF_SCOPE("static_solver.build_feedback_table");
+            m_table.emplace(m_space, m_options.threads);
+        }
+
+        std::vector<rank_type> best = greedy();
+
+        while (best.size() > get_lower_bound()) {
+            std::vector<std::optional<std::vector<rank_type>>> found(m_options.threads);
+            std::vector<std::thread> workers{};
+            for (size_t t{ 0 }; t < m_options.threads; ++t) {
+                workers.emplace_back([this, &found, &best, t]() {
+                    found[t] = local_search(best.size() - 1, m_options.seed + static_cast<std::uint_fast32_t>(t + best.size() * m_options.threads));
+                });
+            }
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+
+            auto it = std::find_if(found.begin(), found.end(), [](const auto& f) { return f.has_value(); });
+            if (it == found.end()) {
+                break;
+            }
+            best = std::move(it->value());
+        }
+
+        std::vector<std::vector<Item>> guesses{};
+        for (rank_type r : best) {
+            guesses.push_back(to_items(m_space.unrank(r)));
+        }
+        return guesses;
+    }
+
+    template<typename Item>
+    bool static_solver<Item>::verify(const std::vector<std::vector<Item>>& guesses) const {
+        MASTERMIND_PERF_SCOPE("static_solver.verify");
+        const size_t code_size = m_space.get_code_size();
+        for (const std::vector<Item>& guess : guesses) {
+            if (guess.size() != code_size) {
+                throw incorrect_code_size_error{ guess.size(), code_size };
+            }
+            if (!are_all_values_different(guess)) {
+                throw indistinct_values_error();
+            }
+            to_indices(guess);
+        }
+
+        const rank_type codes = m_space.size();
+        const size_t width = guesses.size();
+        std::vector<std::uint8_t> signatures(codes * width);
+
+        auto score_secrets = [&](rank_type first, rank_type last) {
+            for (rank_type s{ first }; s < last; ++s) {
+                std::vector<Item> secret = to_items(m_space.unrank(s));
+                for (size_t g{ 0 }; g < width; ++g) {
+                    signatures[s * width + g] = feedback_table::encode(compute_game_result(secret, guesses[g]), code_size);
+                }
+            }
+        };
+
+        size_t threads = std::max<size_t>(1, std::min<size_t>(m_options.threads, codes));
+        std::vector<std::thread> workers{};
+        rank_type chunk = (codes + threads - 1) / threads;
+        for (rank_type first{ 0 }; first < codes; first += chunk) {
+            workers.emplace_back(score_secrets, first, std::min(first + chunk, codes));
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        std::vector<rank_type> order(codes);
+        std::iota(order.begin(), order.end(), 0);
+        auto signature_less = [&](rank_type a, rank_type b) {
+            return std::memcmp(&signatures[a * width], &signatures[b * width], width) < 0;
+        };
+        std::sort(order.begin(), order.end(), signature_less);
+
+        for (rank_type i{ 1 }; i < codes; ++i) {
+            if (!signature_less(order[i - 1], order[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename Item>
+    size_t static_solver<Item>::get_lower_bound() const {
+        if (m_space.size() <= 1) {
+            return 0;
+        }
+        const double feedbacks = static_cast<double>((m_space.get_code_size() + 1) * (m_space.get_code_size() + 2) / 2 - 1);
+        return static_cast<size_t>(std::ceil(std::log(static_cast<double>(m_space.size())) / std::log(feedbacks) - 1e-9));
+    }
+
+    template<typename Item>
+    std::vector<Item> static_solver<Item>::to_items(const std::vector<size_t>& code) const {
+        std::vector<Item> items{};
+        items.reserve(code.size());
+        for (size_t index : code) {
+            items.push_back(m_code_set[index]);
+        }
+        return items;
+    }
+
+    template<typename Item>
+    std::vector<size_t> static_solver<Item>::to_indices(const std::vector<Item>& code) const {
+        std::vector<size_t> indices{};
+        indices.reserve(code.size());
+        for (const Item& value : code) {
+            auto it = std::find(m_code_set.begin(), m_code_set.end(), value);
+            if (it == m_code_set.end()) {
+                throw value_not_in_code_set_error();
+            }
+            indices.push_back(static_cast<size_t>(it - m_code_set.begin()));
+        }
+        return indices;
+    }
+
+    template<typename Item>
+    size_t static_solver<Item>::count_ambiguous(const std::vector<rank_type>& guesses,
+        std::vector<std::uint32_t>& ids, std::vector<std::uint32_t>& remap) const {
+        const rank_type codes = m_space.size();
+        const size_t feedbacks = m_table->get_feedback_count();
+        std::fill(ids.begin(), ids.end(), 0);
+        std::uint32_t classes{ 1 };
+
+        for (rank_type g : guesses) {
+            const feedback_table::feedback_type* row = m_table->row(g);
+            std::fill(remap.begin(), remap.begin() + classes * feedbacks, UINT32_MAX);
+            std::uint32_t next{ 0 };
+            for (rank_type s{ 0 }; s < codes; ++s) {
+                std::uint32_t& id = remap[ids[s] * feedbacks + row[s]];
+                if (id == UINT32_MAX) {
+                    id = next++;
+                }
+                ids[s] = id;
+            }
+            classes = next;
+        }
+
+        std::vector<std::uint32_t> sizes(classes, 0);
+        for (std::uint32_t id : ids) {
+            ++sizes[id];
+        }
+        size_t ambiguous{ 0 };
+        for (std::uint32_t size : sizes) {
+            ambiguous += (size > 1) ? size : 0;
+        }
+        return ambiguous;
+    }
+
+    template<typename Item>
+    std::vector<typename static_solver<Item>::rank_type> static_solver<Item>::greedy() const {
+        MASTERMIND_PERF_SCOPE("static_solver.greedy");
+        const rank_type codes = m_space.size();
+        const size_t feedbacks = m_table->get_feedback_count();
+        std::vector<rank_type> guesses{};
+        std::vector<std::uint32_t> ids(codes, 0);
+        std::vector<rank_type> seen(codes * feedbacks, codes);
+        std::uint32_t classes{ 1 };
+
+        while (classes < codes) {
+            rank_type best_guess{ 0 };
+            size_t best_classes{ 0 };
+            for (rank_type g{ 0 }; g < codes; ++g) {
+                const feedback_table::feedback_type* row = m_table->row(g);
+                size_t refined{ 0 };
+                for (rank_type s{ 0 }; s < codes; ++s) {
+                    rank_type& mark = seen[ids[s] * feedbacks + row[s]];
+                    if (mark != g) {
+                        mark = g;
+                        ++refined;
+                    }
+                }
+                if (refined > best_classes) {
+                    best_classes = refined;
+                    best_guess = g;
+                }
+            }
+
+            if (best_classes == classes) {
+                break;
+            }
+
+            guesses.push_back(best_guess);
+            std::fill(seen.begin(), seen.end(), codes);
+            std::vector<std::uint32_t> remap(classes * feedbacks, UINT32_MAX);
+            const feedback_table::feedback_type* row = m_table->row(best_guess);
+            std::uint32_t next{ 0 };
+            for (rank_type s{ 0 }; s < codes; ++s) {
+                std::uint32_t& id = remap[ids[s] * feedbacks + row[s]];
+                if (id == UINT32_MAX) {
+                    id = next++;
+                }
+                ids[s] = id;
+            }
+            classes = next;
+        }
+        return guesses;
+    }
+
+    template<typename Item>
+    std::optional<std::vector<typename static_solver<Item>::rank_type>> static_solver<Item>::local_search(size_t size, std::uint_fast32_t seed) const {
+        MASTERMIND_PERF_SCOPE("static_solver.local_search");
+        const rank_type codes = m_space.size();
+        std::mt19937 g{ static_cast<std::mt19937::result_type>(seed) };
+        std::uniform_int_distribution<rank_type> any_code{ 0, codes - 1 };
+        std::uniform_int_distribution<size_t> any_position{ 0, size - 1 };
+        std::vector<std::uint32_t> ids(codes);
+        std::vector<std::uint32_t> remap(codes * m_table->get_feedback_count());
+
+        std::vector<rank_type> current(size);
+        for (rank_type& guess : current) {
+            guess = any_code(g);
+        }
+        size_t cost = count_ambiguous(current, ids, remap);
+
+        for (size_t iteration{ 0 }; iteration < m_options.max_iterations && cost > 0; ++iteration) {
+            size_t position = any_position(g);
+            rank_type previous = current[position];
+            current[position] = any_code(g);
+            size_t candidate_cost = count_ambiguous(current, ids, remap);
+            if (candidate_cost <= cost) {
+                cost = candidate_cost;
+            }
+            else {
+                current[position] = previous;
+            }
+        }
+
+        if (cost > 0) {
+            return std::nullopt;
+        }
+        return current;
+    }
+
+}
@@ -1,8 +1,21 @@
 #pragma once
 
 
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MASTERMIND_HAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define MASTERMIND_HAS_SSE2 0
+#endif
+
 
 namespace mastermind {
 
@@ -12,6 +25,11 @@ namespace mastermind {
         ENDED
     };
 
+    enum class code_rule {
+        DISTINCT_VALUES,
+        REPEATED_VALUES
+    };
+
     struct game_start_params {
         size_t code_size;
         size_t max_tries;
@@ -35,4 +53,185 @@ namespace mastermind {
         return true;
     }
 
+    // Codes of different sizes are scored by looking up every guessed value in the whole
+    // code pattern; such a result is never valid.
+    template<typename Item>
+    game_result compute_game_result(const Item* code_pattern, const Item* s, size_t code_size, size_t guess_size) {
+        size_t in_place{ 0 };
+        size_t in_color{ 0 };
+
+        for (size_t i = 0; i < guess_size; ++i) {
+            for (size_t j = 0; j < code_size; ++j) {
+                if (s[i] == code_pattern[j]) {
+                    if (i == j) {
+                        ++in_place;
+                    }
+                    else {
+                        ++in_color;
+                    }
+                    break;
+                }
+            }
+        }
+
+        return game_result{ (in_place == code_size && guess_size == code_size), in_place, in_color };
+    }
+
+    template<typename Item>
+    game_result compute_game_result(const std::vector<Item>& code_pattern, const std::vector<Item>& s) {
+        return compute_game_result(code_pattern.data(), s.data(), code_pattern.size(), s.size());
+    }
+
+    // Scores count pairs of codes with distinct values, the pair i having sizes[i] values.
+    // Integral values in [0, 64) are folded into one bit mask per code, so the values a
+    // pair has in common take a single popcount instead of the nested loop.
+    template<typename Item>
+    void compute_game_results(const Item* const* code_patterns, const Item* const* guesses, const size_t* sizes, size_t count, game_result* results) {
+        for (size_t k{ 0 }; k < count; ++k) {
+            const Item* code_pattern = code_patterns[k];
+            const Item* s = guesses[k];
+            const size_t size = sizes[k];
+
+            if constexpr (std::is_integral<Item>::value) {
+                std::uint64_t code_mask{ 0 };
+                std::uint64_t guess_mask{ 0 };
+                std::uint64_t out_of_range{ 0 };
+                size_t in_place{ 0 };
+                for (size_t i{ 0 }; i < size; ++i) {
+                    const std::uint64_t a = static_cast<std::uint64_t>(code_pattern[i]);
+                    const std::uint64_t b = static_cast<std::uint64_t>(s[i]);
+                    out_of_range |= (a | b) >> 6;
+                    code_mask |= std::uint64_t{ 1 } << (a & 63);
+                    guess_mask |= std::uint64_t{ 1 } << (b & 63);
+                    in_place += (a == b) ? 1 : 0;
+                }
+                if (out_of_range == 0) {
+                    const size_t common = std::bitset<64>{ code_mask & guess_mask }.count();
+                    results[k] = game_result{ (in_place == size), in_place, common - in_place };
+                    continue;
+                }
+            }
+            results[k] = compute_game_result(code_pattern, s, size, size);
+        }
+    }
+
+    // Number of values the two codes have in common, counting repeats: the sum over
+    // every value of the smaller of its two multiplicities.
+    template<typename Item>
+    size_t count_common_values_sorted(const Item* code_pattern, const Item* s, size_t size) {
+        std::vector<Item> a(code_pattern, code_pattern + size);
+        std::vector<Item> b(s, s + size);
+        std::sort(a.begin(), a.end());
+        std::sort(b.begin(), b.end());
+
+        size_t common{ 0 };
+        for (size_t i{ 0 }, j{ 0 }; i < size && j < size;) {
+            if (a[i] < b[j]) {
+                ++i;
+            }
+            else if (b[j] < a[i]) {
+                ++j;
+            }
+            else {
+                ++common;
+                ++i;
+                ++j;
+            }
+        }
+        return common;
+    }
+
+    // Count-min over per-value histograms; values are offsets in [0, colors) after
+    // subtracting base. O(size + colors).
+    template<typename Item>
+    size_t count_common_values_histogram(const Item* code_pattern, const Item* s, size_t size, Item base, size_t colors) {
+        std::array<std::uint32_t, 256> in_code;
+        std::array<std::uint32_t, 256> in_guess;
+        std::fill_n(in_code.begin(), colors, 0);
+        std::fill_n(in_guess.begin(), colors, 0);
+
+        for (size_t i{ 0 }; i < size; ++i) {
+            ++in_code[static_cast<size_t>(code_pattern[i] - base)];
+            ++in_guess[static_cast<size_t>(s[i] - base)];
+        }
+
+        size_t common{ 0 };
+        for (size_t c{ 0 }; c < colors; ++c) {
+            common += std::min(in_code[c], in_guess[c]);
+        }
+        return common;
+    }
+
+#if MASTERMIND_HAS_SSE2
+    // Same count-min with both histograms held in one register each: one byte lane per
+    // value, so it needs colors <= 16 and size < 256.
+    template<typename Item>
+    size_t count_common_values_sse2(const Item* code_pattern, const Item* s, size_t size, Item base) {
+        const __m128i lanes = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        __m128i in_code = _mm_setzero_si128();
+        __m128i in_guess = _mm_setzero_si128();
+
+        for (size_t i{ 0 }; i < size; ++i) {
+            __m128i code_value = _mm_set1_epi8(static_cast<char>(code_pattern[i] - base));
+            __m128i guess_value = _mm_set1_epi8(static_cast<char>(s[i] - base));
+            in_code = _mm_sub_epi8(in_code, _mm_cmpeq_epi8(code_value, lanes));
+            in_guess = _mm_sub_epi8(in_guess, _mm_cmpeq_epi8(guess_value, lanes));
+        }
+
+        __m128i sums = _mm_sad_epu8(_mm_min_epu8(in_code, in_guess), _mm_setzero_si128());
+        return static_cast<size_t>(_mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4));
+    }
+#endif
+
+    // Scoring for codes that may repeat values. Integral values spanning at most 256
+    // consecutive numbers go through the histogram kernels, anything else is sorted.
+    template<typename Item>
+    game_result compute_game_result_with_repeats(const Item* code_pattern, const Item* s, size_t size) {
+        size_t in_place{ 0 };
+        for (size_t i{ 0 }; i < size; ++i) {
+            in_place += (code_pattern[i] == s[i]) ? 1 : 0;
+        }
+
+        size_t common{ 0 };
+        if constexpr (std::is_integral<Item>::value) {
+            if (size == 0) {
+                return game_result{ true, 0, 0 };
+            }
+            Item low = code_pattern[0];
+            Item high = code_pattern[0];
+            for (size_t i{ 0 }; i < size; ++i) {
+                low = std::min(low, std::min(code_pattern[i], s[i]));
+                high = std::max(high, std::max(code_pattern[i], s[i]));
+            }
+            const std::uint64_t span = static_cast<std::uint64_t>(high) - static_cast<std::uint64_t>(low);
+
+#if MASTERMIND_HAS_SSE2
+            if (span < 16 && size < 256) {
+                common = count_common_values_sse2(code_pattern, s, size, low);
+            }
+            else
+#endif
+            if (span < 256) {
+                common = count_common_values_histogram(code_pattern, s, size, low, static_cast<size_t>(span) + 1);
+            }
+            else {
+                common = count_common_values_sorted(code_pattern, s, size);
+            }
+        }
+        else {
+            common = count_common_values_sorted(code_pattern, s, size);
+        }
+
+        return game_result{ (in_place == size), in_place, common - in_place };
+    }
+
+    template<typename Item>
+    game_result compute_game_result_with_repeats(const std::vector<Item>& code_pattern, const std::vector<Item>& s) {
+        if (s.size() != code_pattern.size()) {
+            game_result prefix = compute_game_result_with_repeats(code_pattern.data(), s.data(), std::min(s.size(), code_pattern.size()));
+            return game_result{ false, prefix.pegs_in_right_place, prefix.pegs_in_right_color };
+        }
+        return compute_game_result_with_repeats(code_pattern.data(), s.data(), s.size());
+    }
+
 }
@@ -0,0 +1,126 @@
+#include "../include/mastermind_anytime_solver.hpp"
+#include "../include/mastermind_code_space.hpp"
+#include "gmock/gmock.h"
+#include <numeric>
+
+
+class MastermindAnytimeSolverTest : public ::testing::Test {
+public:
+    const std::uint_fast32_t SEED{ 12345 };
+    const std::chrono::microseconds AMPLE_BUDGET{ 10000000 };
+    std::vector<int> code_set;
+
+    MastermindAnytimeSolverTest() : code_set(6) {
+        std::iota(code_set.begin(), code_set.end(), 0);
+    }
+
+    size_t play(mastermind::anytime_solver<int>& solver, const std::vector<int>& secret, size_t max_tries) {
+        for (size_t tries{ 1 }; tries <= max_tries; ++tries) {
+            auto guess = solver.next_guess(AMPLE_BUDGET);
+            auto result = mastermind::compute_game_result(secret, guess);
+            if (result.valid) {
+                return tries;
+            }
+            solver.add_feedback(guess, result);
+        }
+        return max_tries + 1;
+    }
+};
+
+
+TEST_F(MastermindAnytimeSolverTest, ShouldThrowIndistinctValuesErrorForCodeSetWithRepeatedElements) {
+    EXPECT_THROW((mastermind::anytime_solver<int>{ { 1, 2, 2, 3 }, { 2, 8 } }), mastermind::indistinct_values_error);
+}
+
+TEST_F(MastermindAnytimeSolverTest, ShouldCoverWholeCandidateSpaceWithAmpleBudget) {
+    mastermind::anytime_solver<int> solver{ code_set, { 4, 8 }, {}, SEED };
+    solver.add_feedback({ 0, 1, 2, 3 }, mastermind::compute_game_result(std::vector<int>{ 5, 2, 0, 4 }, std::vector<int>{ 0, 1, 2, 3 }));
+
+    auto guess = solver.next_guess(AMPLE_BUDGET);
+    const auto& progress = solver.get_progress();
+
+    EXPECT_TRUE(mastermind::are_all_values_different(guess));
+    EXPECT_TRUE(progress.secrets_complete);
+    EXPECT_EQ(progress.consistent_scored, progress.secrets);
+    EXPECT_DOUBLE_EQ(progress.get_consistent_coverage(), 1.0);
+    EXPECT_TRUE(progress.representatives_complete);
+    EXPECT_GT(progress.representatives_scored, 0u);
+    EXPECT_FALSE(progress.deadline_reached);
+}
+
+TEST_F(MastermindAnytimeSolverTest, ShouldFirstGuessHaveNoRepresentativeBesidesConsistentCodes) {
+    mastermind::anytime_solver<int> solver{ code_set, { 4, 8 }, {}, SEED };
+
+    solver.next_guess(AMPLE_BUDGET);
+
+    EXPECT_EQ(solver.get_progress().secrets, mastermind::code_space(6, 4).size());
+    EXPECT_EQ(solver.get_progress().representatives_scored, 0u);
+    EXPECT_TRUE(solver.get_progress().representatives_complete);
+}
+
+TEST_F(MastermindAnytimeSolverTest, ShouldReturnConsistentGuessWhenDeadlineAlreadyPassed) {
+    std::vector<int> large_code_set(40);
+    std::iota(large_code_set.begin(), large_code_set.end(), 0);
+    mastermind::anytime_solver<int> solver{ large_code_set, { 8, 20 }, {}, SEED };
+    const std::vector<int> secret{ 3, 17, 25, 0, 39, 8, 12, 30 };
+    const std::vector<int> first{ 0, 1, 2, 3, 4, 5, 6, 7 };
+    solver.add_feedback(first, mastermind::compute_game_result(secret, first));
+
+    auto guess = solver.next_guess(mastermind::anytime_solver<int>::clock_type::now());
+
+    auto expected = mastermind::compute_game_result(secret, first);
+    auto actual = mastermind::compute_game_result(guess, first);
+    EXPECT_EQ(actual.pegs_in_right_place, expected.pegs_in_right_place);
+    EXPECT_EQ(actual.pegs_in_right_color, expected.pegs_in_right_color);
+    EXPECT_TRUE(solver.get_progress().deadline_reached);
+    EXPECT_EQ(solver.get_progress().get_guesses_scored(), 1u);
+}
+
+TEST_F(MastermindAnytimeSolverTest, ShouldStopSearchForSecretsAtDeadlineOnSparseBoard) {
+    std::vector<int> large_code_set(40);
+    std::iota(large_code_set.begin(), large_code_set.end(), 0);
+    mastermind::anytime_solver<int> solver{ large_code_set, { 10, 30 }, {}, SEED };
+    const std::vector<int> secret{ 3, 14, 19, 39, 12, 1, 0, 38, 29, 20 };
+    const std::vector<std::vector<int>> guesses{
+        { 3, 2, 0, 6, 5, 38, 9, 21, 1, 14 }, { 32, 13, 36, 24, 14, 16, 23, 6, 21, 10 },
+        { 18, 32, 34, 15, 22, 1, 17, 36, 26, 37 }, { 14, 21, 23, 17, 24, 31, 26, 3, 25, 28 },
+        { 6, 9, 33, 34, 26, 29, 22, 30, 16, 27 }, { 23, 19, 21, 14, 4, 2, 35, 20, 10, 27 } };
+    for (const auto& guess : guesses) {
+        solver.add_feedback(guess, mastermind::compute_game_result(secret, guess));
+    }
+
+    auto guess = solver.next_guess(mastermind::anytime_solver<int>::clock_type::now());
+
+    EXPECT_EQ(guess.size(), secret.size());
+    EXPECT_TRUE(solver.get_progress().deadline_reached);
+    EXPECT_FALSE(solver.get_progress().secrets_complete);
+    EXPECT_LE(solver.get_progress().search_nodes, mastermind::consistency_engine<size_t>::stop_check_interval);
+}
+
+TEST_F(MastermindAnytimeSolverTest, ShouldReportProgressThroughCallback) {
+    mastermind::anytime_solver<int> solver{ code_set, { 4, 8 }, {}, SEED };
+    size_t reports{ 0 };
+    size_t scored{ 0 };
+    solver.set_progress_callback([&](const mastermind::anytime_progress& progress) {
+        ++reports;
+        scored = progress.get_guesses_scored();
+    });
+
+    solver.next_guess(AMPLE_BUDGET);
+
+    EXPECT_EQ(reports, 1u);
+    EXPECT_EQ(scored, solver.get_progress().get_guesses_scored());
+}
+
+TEST_F(MastermindAnytimeSolverTest, ShouldSolveSmallBoardWithinMaxTries) {
+    mastermind::code_space space{ 6, 4 };
+    for (mastermind::code_space::rank_type r{ 0 }; r < space.size(); r += 29) {
+        std::vector<int> secret{};
+        for (size_t color : space.unrank(r)) {
+            secret.push_back(static_cast<int>(color));
+        }
+        mastermind::anytime_solver<int> solver{ code_set, { 4, 8 }, {}, SEED };
+
+        EXPECT_LE(play(solver, secret, 8), 8u) << "rank " << r;
+    }
+}
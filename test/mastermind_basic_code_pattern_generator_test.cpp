@@ -0,0 +1,63 @@
+#include "../include/mastermind_basic_code_pattern_generator.hpp"
+#include "gmock/gmock.h"
+
+
+TEST(MastermindBasicCodePatternGeneratorTest, ShouldGenerateDistinctValuesByDefault) {
+    mastermind::basic_code_pattern_generator<int> generator{ { 1, 2, 3, 4, 5 } };
+
+    for (int round{ 0 }; round < 100; ++round) {
+        auto pattern = generator(5);
+        ASSERT_EQ(pattern.size(), 5u);
+        EXPECT_TRUE(mastermind::are_all_values_different(pattern));
+    }
+}
+
+TEST(MastermindBasicCodePatternGeneratorTest, ShouldGenerateRepeatedValuesWhenAllowed) {
+    mastermind::basic_code_pattern_generator<int> generator{ { 1, 2 }, mastermind::code_rule::REPEATED_VALUES };
+    bool repeated{ false };
+
+    for (int round{ 0 }; round < 100; ++round) {
+        auto pattern = generator(6);
+        ASSERT_EQ(pattern.size(), 6u);
+        for (int value : pattern) {
+            EXPECT_TRUE(value == 1 || value == 2);
+        }
+        repeated = repeated || !mastermind::are_all_values_different(pattern);
+    }
+    EXPECT_TRUE(repeated);
+}
+
+TEST(MastermindBasicCodePatternGeneratorTest, ShouldThrowCodeSetTooSmallErrorForEmptyCodeSetWithRepeatedValues) {
+    mastermind::basic_code_pattern_generator<int> generator{ {}, mastermind::code_rule::REPEATED_VALUES };
+
+    EXPECT_THROW(generator(4), mastermind::code_set_too_small_error);
+}
+
+TEST(MastermindBasicCodePatternGeneratorTest, ShouldGenerateOnlySecretsOfTheDifficultyBand) {
+    mastermind::code_space space{ 6, 4 };
+    auto index = std::make_shared<const mastermind::difficulty_index>(mastermind::difficulty_index::build(space, 2));
+    const std::vector<char> code_set{ 'a', 'b', 'c', 'd', 'e', 'f' };
+    mastermind::basic_code_pattern_generator<char> generator{ code_set, index, { 4, 4 } };
+
+    for (int round{ 0 }; round < 100; ++round) {
+        auto pattern = generator(4);
+        std::vector<size_t> code{};
+        for (char value : pattern) {
+            code.push_back(static_cast<size_t>(value - 'a'));
+        }
+        EXPECT_EQ(index->get_difficulty(space.rank(code)), 4u);
+    }
+    EXPECT_THROW(generator(3), mastermind::incorrect_code_size_error);
+}
+
+TEST(MastermindBasicCodePatternGeneratorTest, ShouldThrowEmptyDifficultyBandErrorForBandWithoutSecrets) {
+    auto index = std::make_shared<const mastermind::difficulty_index>(mastermind::difficulty_index::build({ 6, 4 }, 1));
+
+    EXPECT_THROW((mastermind::basic_code_pattern_generator<int>{ { 1, 2, 3, 4, 5, 6 }, index, { 100, 200 } }),
+        mastermind::empty_difficulty_band_error);
+}
+
+TEST(MastermindBasicCodePatternGeneratorTest, ShouldThrowDifficultyIndexErrorForMissingIndex) {
+    EXPECT_THROW((mastermind::basic_code_pattern_generator<int>{ { 1, 2, 3, 4, 5, 6 }, nullptr, { 1, 2 } }),
+        mastermind::difficulty_index_error);
+}
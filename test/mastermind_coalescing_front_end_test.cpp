@@ -0,0 +1,152 @@
+#include "../include/mastermind_coalescing_front_end.hpp"
+#include "gmock/gmock.h"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+
+class MastermindCoalescingFrontEndTest : public ::testing::Test {
+public:
+    const std::vector<int> TEST_CORRECT_SOLUTION{ { 1, 2, 3, 4, 5 } };
+
+    mastermind::mastermind_engine<int> make_engine(size_t max_tries = 8) {
+        mastermind::mastermind_engine<int> engine{ [this](size_t) { return TEST_CORRECT_SOLUTION; } };
+        engine.start_game({ TEST_CORRECT_SOLUTION.size(), max_tries });
+        return engine;
+    }
+};
+
+
+TEST_F(MastermindCoalescingFrontEndTest, ShouldCompleteFutureWithEngineResult) {
+    mastermind::coalescing_front_end<int> front_end{};
+    auto engine = make_engine();
+
+    auto result = front_end.check_solution(engine, { 1, 3, 2, 4, 6 }).get();
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result.value().pegs_in_right_place, 2u);
+    EXPECT_EQ(result.value().pegs_in_right_color, 2u);
+    EXPECT_EQ(engine.get_tries_left(), 7u);
+}
+
+TEST_F(MastermindCoalescingFrontEndTest, ShouldPassEngineErrorsToFuture) {
+    mastermind::coalescing_front_end<int> front_end{};
+    auto engine = make_engine();
+
+    auto result = front_end.check_solution(engine, { 1, 2 });
+
+    EXPECT_THROW(result.get(), mastermind::incorrect_code_size_error);
+}
+
+TEST_F(MastermindCoalescingFrontEndTest, ShouldApplyGuessesForSameEngineInOrder) {
+    mastermind::coalescing_front_end<int> front_end{ { 64, std::chrono::microseconds{ 2000 } } };
+    auto engine = make_engine(3);
+
+    auto first = front_end.check_solution(engine, { 5, 4, 3, 2, 1 });
+    auto second = front_end.check_solution(engine, TEST_CORRECT_SOLUTION);
+    auto third = front_end.check_solution(engine, { 5, 4, 3, 2, 1 });
+
+    EXPECT_FALSE(first.get().value().valid);
+    EXPECT_TRUE(second.get().value().valid);
+    EXPECT_TRUE(third.get().value().valid);
+    EXPECT_EQ(engine.get_status(), mastermind::game_status::ENDED);
+}
+
+TEST_F(MastermindCoalescingFrontEndTest, ShouldCoalesceConcurrentGuessesIntoBatches) {
+    const size_t threads{ 4 };
+    const size_t guesses_per_thread{ 500 };
+    std::vector<mastermind::mastermind_engine<int>> engines{};
+    for (size_t t{ 0 }; t < threads; ++t) {
+        engines.push_back(make_engine(guesses_per_thread + 1));
+    }
+    std::atomic<size_t> callbacks{ 0 };
+    std::atomic<size_t> wrong{ 0 };
+
+    {
+        mastermind::coalescing_front_end<int> front_end{ { 128, std::chrono::microseconds{ 200 } } };
+        std::vector<std::thread> workers{};
+        for (size_t t{ 0 }; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                for (size_t i{ 0 }; i < guesses_per_thread; ++i) {
+                    front_end.check_solution(engines[t], { 2, 1, 3, 5, 4 }, [&](std::optional<mastermind::game_result> result, std::exception_ptr error) {
+                        if (error || !result || result.value().pegs_in_right_place != 1 || result.value().pegs_in_right_color != 4) {
+                            ++wrong;
+                        }
+                        ++callbacks;
+                    });
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        while (callbacks < threads * guesses_per_thread) {
+            std::this_thread::yield();
+        }
+
+        EXPECT_EQ(front_end.get_requests(), threads * guesses_per_thread);
+    }
+
+    EXPECT_EQ(wrong, 0u);
+    for (const auto& engine : engines) {
+        EXPECT_EQ(engine.get_tries_left(), 1u);
+    }
+}
+
+TEST_F(MastermindCoalescingFrontEndTest, ShouldScoreGuessesSubmittedWithinWindowInOneBatch) {
+    const size_t guesses{ 16 };
+    mastermind::coalescing_front_end<int> front_end{ { guesses, std::chrono::seconds{ 10 } } };
+    std::vector<mastermind::mastermind_engine<int>> engines{};
+    for (size_t i{ 0 }; i < guesses; ++i) {
+        engines.push_back(make_engine());
+    }
+
+    std::vector<std::future<std::optional<mastermind::game_result>>> results{};
+    for (auto& engine : engines) {
+        results.push_back(front_end.check_solution(engine, { 2, 1, 3, 5, 4 }));
+    }
+    for (auto& result : results) {
+        EXPECT_EQ(result.get().value().pegs_in_right_place, 1u);
+    }
+
+    EXPECT_EQ(front_end.get_batches(), 1u);
+    EXPECT_EQ(front_end.get_requests(), guesses);
+}
+
+TEST_F(MastermindCoalescingFrontEndTest, ShouldCompleteRestOfBatchWhenCallbackThrows) {
+    mastermind::coalescing_front_end<int> front_end{ { 2, std::chrono::seconds{ 10 } } };
+    auto engine = make_engine();
+    auto other_engine = make_engine();
+
+    front_end.check_solution(engine, { 5, 4, 3, 2, 1 }, [](std::optional<mastermind::game_result>, std::exception_ptr) {
+        throw std::runtime_error{ "callback failed" };
+    });
+    auto result = front_end.check_solution(other_engine, TEST_CORRECT_SOLUTION);
+
+    EXPECT_TRUE(result.get().value().valid);
+    EXPECT_EQ(engine.get_tries_left(), 7u);
+    EXPECT_EQ(front_end.get_callback_errors(), 1u);
+}
+
+TEST(MastermindBatchScoringTest, ShouldComputeGameResultsMatchComputeGameResult) {
+    const std::vector<std::vector<long long>> secrets{ { 0, 1, 2, 3 }, { 63, 10, 7, 5 }, { 64, 200, -1, 3 } };
+    const std::vector<std::vector<long long>> guesses{ { 3, 2, 1, 0 }, { 63, 5, 10, 1 }, { -1, 200, 64, 9 } };
+    std::vector<const long long*> secret_pointers{};
+    std::vector<const long long*> guess_pointers{};
+    std::vector<size_t> sizes{};
+    for (size_t i{ 0 }; i < secrets.size(); ++i) {
+        secret_pointers.push_back(secrets[i].data());
+        guess_pointers.push_back(guesses[i].data());
+        sizes.push_back(secrets[i].size());
+    }
+    std::vector<mastermind::game_result> results(secrets.size());
+
+    mastermind::compute_game_results(secret_pointers.data(), guess_pointers.data(), sizes.data(), secrets.size(), results.data());
+
+    for (size_t i{ 0 }; i < secrets.size(); ++i) {
+        auto expected = mastermind::compute_game_result(secrets[i], guesses[i]);
+        EXPECT_EQ(results[i].valid, expected.valid);
+        EXPECT_EQ(results[i].pegs_in_right_place, expected.pegs_in_right_place);
+        EXPECT_EQ(results[i].pegs_in_right_color, expected.pegs_in_right_color);
+    }
+}
@@ -0,0 +1,61 @@
+#include "../include/mastermind_code_space.hpp"
+#include "gmock/gmock.h"
+
+
+TEST(MastermindCodeSpaceTest, ShouldSizeBeTheNumberOfPartialPermutations) {
+    EXPECT_EQ(mastermind::code_space(8, 5).size(), 6720u);
+    EXPECT_EQ(mastermind::code_space(6, 4).size(), 360u);
+    EXPECT_EQ(mastermind::code_space(32, 8).size(), 424097856000u);
+}
+
+TEST(MastermindCodeSpaceTest, ShouldThrowCodeSetTooSmallErrorIfCodeSizeExceedsCodeSet) {
+    EXPECT_THROW(mastermind::code_space(3, 4), mastermind::code_set_too_small_error);
+}
+
+TEST(MastermindCodeSpaceTest, ShouldThrowCodeSpaceTooLargeErrorOnOverflow) {
+    EXPECT_THROW(mastermind::code_space(64, 32), mastermind::code_space_too_large_error);
+}
+
+TEST(MastermindCodeSpaceTest, ShouldUnrankInLexicographicOrder) {
+    mastermind::code_space space{ 4, 2 };
+
+    EXPECT_THAT(space.unrank(0), ::testing::ElementsAre(0, 1));
+    EXPECT_THAT(space.unrank(1), ::testing::ElementsAre(0, 2));
+    EXPECT_THAT(space.unrank(3), ::testing::ElementsAre(1, 0));
+    EXPECT_THAT(space.unrank(11), ::testing::ElementsAre(3, 2));
+}
+
+TEST(MastermindCodeSpaceTest, ShouldRankBeInverseOfUnrank) {
+    mastermind::code_space space{ 7, 4 };
+
+    for (mastermind::code_space::rank_type r{ 0 }; r < space.size(); ++r) {
+        auto code = space.unrank(r);
+        ASSERT_TRUE(mastermind::are_all_values_different(code));
+        ASSERT_EQ(space.rank(code), r);
+    }
+}
+
+TEST(MastermindFeedbackTableTest, ShouldMatchTheEngineScoringRule) {
+    mastermind::code_space space{ 6, 4 };
+    mastermind::feedback_table table{ space, 3 };
+
+    for (mastermind::code_space::rank_type g{ 0 }; g < space.size(); g += 7) {
+        for (mastermind::code_space::rank_type s{ 0 }; s < space.size(); ++s) {
+            auto expected = mastermind::compute_game_result(space.unrank(s), space.unrank(g));
+            ASSERT_EQ(table(g, s), mastermind::feedback_table::encode(expected, 4));
+        }
+    }
+}
+
+TEST(MastermindFeedbackTableTest, ShouldDecodeBeInverseOfEncode) {
+    mastermind::game_result result = mastermind::feedback_table::decode(mastermind::feedback_table::encode({ false, 2, 1 }, 4), 4);
+
+    EXPECT_FALSE(result.valid);
+    EXPECT_EQ(result.pegs_in_right_place, 2);
+    EXPECT_EQ(result.pegs_in_right_color, 1);
+    EXPECT_TRUE(mastermind::feedback_table::decode(mastermind::feedback_table::encode({ true, 4, 0 }, 4), 4).valid);
+}
+
+TEST(MastermindFeedbackTableTest, ShouldThrowCodeSpaceTooLargeErrorForBigBoards) {
+    EXPECT_THROW(mastermind::feedback_table(mastermind::code_space{ 10, 5 }), mastermind::code_space_too_large_error);
+}
@@ -0,0 +1,140 @@
+#include "../include/mastermind_consistency_engine.hpp"
+#include "gmock/gmock.h"
+#include <numeric>
+#include <random>
+
+
+class MastermindConsistencyEngineTest : public ::testing::Test {
+public:
+    const size_t CODE_SIZE{ 4 };
+    const std::vector<int> TEST_CORRECT_SOLUTION{ { 5, 2, 7, 0 } };
+    std::vector<int> code_set;
+
+    MastermindConsistencyEngineTest() : code_set(8) {
+        std::iota(code_set.begin(), code_set.end(), 0);
+    }
+
+    void add_feedback_for(mastermind::consistency_engine<int>& engine, const std::vector<int>& guess) {
+        engine.add_feedback(guess, mastermind::compute_game_result(TEST_CORRECT_SOLUTION, guess));
+    }
+};
+
+
+TEST_F(MastermindConsistencyEngineTest, ShouldThrowCodeSetTooLargeErrorForMoreThan64Values) {
+    std::vector<int> large_code_set(65);
+    std::iota(large_code_set.begin(), large_code_set.end(), 0);
+
+    EXPECT_THROW((mastermind::consistency_engine<int>{ large_code_set, { 4, 8 } }), mastermind::code_set_too_large_error);
+}
+
+TEST_F(MastermindConsistencyEngineTest, ShouldEveryCodeBeConsistentWithoutFeedback) {
+    mastermind::consistency_engine<int> engine{ code_set, { CODE_SIZE, 8 } };
+
+    EXPECT_TRUE(engine.is_consistent(TEST_CORRECT_SOLUTION));
+    EXPECT_EQ(engine.find_consistent(), std::optional<std::vector<int>>(std::vector<int>{ { 0, 1, 2, 3 } }));
+}
+
+TEST_F(MastermindConsistencyEngineTest, ShouldIsConsistentRejectCodesWithRepeatedOrUnknownValues) {
+    mastermind::consistency_engine<int> engine{ code_set, { CODE_SIZE, 8 } };
+
+    EXPECT_FALSE(engine.is_consistent({ 1, 1, 2, 3 }));
+    EXPECT_FALSE(engine.is_consistent({ 1, 2, 3, 42 }));
+    EXPECT_FALSE(engine.is_consistent({ 1, 2, 3 }));
+}
+
+TEST_F(MastermindConsistencyEngineTest, ShouldZeroPegsFeedbackRemoveGuessColorsFromEveryDomain) {
+    mastermind::consistency_engine<int> engine{ code_set, { CODE_SIZE, 8 } };
+
+    engine.add_feedback({ 1, 3, 4, 6 }, { false, 0, 0 });
+
+    for (size_t i{ 0 }; i < CODE_SIZE; ++i) {
+        EXPECT_EQ(engine.get_domain(i), 0b10100101u);
+    }
+}
+
+TEST_F(MastermindConsistencyEngineTest, ShouldEnumerateExactlyTheCodesConsistentWithFeedback) {
+    mastermind::consistency_engine<int> engine{ code_set, { CODE_SIZE, 8 } };
+    add_feedback_for(engine, { 0, 1, 2, 3 });
+    add_feedback_for(engine, { 4, 5, 6, 7 });
+
+    size_t found{ 0 };
+    engine.for_each_consistent([&](const std::vector<int>& code) {
+        EXPECT_TRUE(engine.is_consistent(code));
+        ++found;
+        return true;
+    });
+
+    size_t expected{ 0 };
+    std::vector<int> code(CODE_SIZE);
+    for (code[0] = 0; code[0] < 8; ++code[0])
+        for (code[1] = 0; code[1] < 8; ++code[1])
+            for (code[2] = 0; code[2] < 8; ++code[2])
+                for (code[3] = 0; code[3] < 8; ++code[3]) {
+                    if (!mastermind::are_all_values_different(code)) continue;
+                    auto a = mastermind::compute_game_result(code, std::vector<int>{ { 0, 1, 2, 3 } });
+                    auto b = mastermind::compute_game_result(TEST_CORRECT_SOLUTION, std::vector<int>{ { 0, 1, 2, 3 } });
+                    auto c = mastermind::compute_game_result(code, std::vector<int>{ { 4, 5, 6, 7 } });
+                    auto d = mastermind::compute_game_result(TEST_CORRECT_SOLUTION, std::vector<int>{ { 4, 5, 6, 7 } });
+                    if (a.pegs_in_right_place == b.pegs_in_right_place && a.pegs_in_right_color == b.pegs_in_right_color &&
+                        c.pegs_in_right_place == d.pegs_in_right_place && c.pegs_in_right_color == d.pegs_in_right_color) {
+                        ++expected;
+                    }
+                }
+
+    EXPECT_EQ(found, expected);
+}
+
+TEST_F(MastermindConsistencyEngineTest, ShouldFindConsistentReturnNulloptForContradictoryFeedback) {
+    mastermind::consistency_engine<int> engine{ code_set, { CODE_SIZE, 8 } };
+
+    engine.add_feedback({ 0, 1, 2, 3 }, { false, 0, 0 });
+    engine.add_feedback({ 0, 1, 2, 3 }, { false, 1, 0 });
+
+    EXPECT_EQ(engine.find_consistent(), std::nullopt);
+    EXPECT_FALSE(engine.is_search_truncated());
+}
+
+TEST_F(MastermindConsistencyEngineTest, ShouldSearchStopAtNodeLimit) {
+    mastermind::consistency_engine<int> engine{ code_set, { CODE_SIZE, 8 } };
+    engine.set_node_limit(2);
+
+    EXPECT_EQ(engine.find_consistent(), std::nullopt);
+    EXPECT_TRUE(engine.is_search_truncated());
+}
+
+TEST_F(MastermindConsistencyEngineTest, ShouldSearchStopWhenStopPredicateHolds) {
+    mastermind::consistency_engine<int> engine{ code_set, { CODE_SIZE, 8 } };
+    std::mt19937 g{ 7 };
+    size_t checks{ 0 };
+    size_t found{ 0 };
+
+    engine.for_each_consistent(g, [&found](const std::vector<int>&) {
+        ++found;
+        return true;
+    }, [&checks]() { return ++checks == 3; });
+
+    EXPECT_TRUE(engine.is_search_truncated());
+    EXPECT_EQ(engine.get_nodes_visited(), 3 * mastermind::consistency_engine<int>::stop_check_interval);
+    EXPECT_GT(found, 0u);
+}
+
+TEST_F(MastermindConsistencyEngineTest, ShouldFindConsistentCodeQuicklyOnLargeBoard) {
+    std::vector<int> large_code_set(32);
+    std::iota(large_code_set.begin(), large_code_set.end(), 0);
+    std::mt19937 g{ 7 };
+    std::vector<int> secret{ large_code_set };
+    std::shuffle(secret.begin(), secret.end(), g);
+    secret.resize(10);
+    mastermind::consistency_engine<int> engine{ large_code_set, { 10, 30 } };
+
+    for (size_t turn{ 0 }; turn < 8; ++turn) {
+        auto guess = engine.find_consistent(g);
+        ASSERT_TRUE(guess.has_value());
+        auto result = mastermind::compute_game_result(secret, guess.value());
+        if (result.valid) {
+            break;
+        }
+        engine.add_feedback(guess.value(), result);
+        EXPECT_TRUE(engine.is_consistent(secret));
+    }
+}
@@ -0,0 +1,111 @@
+#include "../include/mastermind_difficulty_index.hpp"
+#include "gmock/gmock.h"
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+class MastermindDifficultyIndexTest : public ::testing::Test {
+public:
+    const std::string TEST_PATH{ ::testing::TempDir() + "mastermind_difficulty_index_test_" +
+        ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".idx" };
+    mastermind::code_space space{ 6, 4 };
+
+    void TearDown() override {
+        std::remove(TEST_PATH.c_str());
+    }
+
+    // Plays the reference strategy against one secret the slow way.
+    size_t play(mastermind::code_space::rank_type secret) const {
+        std::vector<std::pair<std::vector<size_t>, mastermind::game_result>> history{};
+        const std::vector<size_t> secret_code = space.unrank(secret);
+        for (mastermind::code_space::rank_type r{ 0 }; r < space.size(); ++r) {
+            const std::vector<size_t> code = space.unrank(r);
+            bool consistent{ true };
+            for (const auto& [guess, result] : history) {
+                auto expected = mastermind::compute_game_result(code, guess);
+                consistent = consistent && expected.pegs_in_right_place == result.pegs_in_right_place
+                    && expected.pegs_in_right_color == result.pegs_in_right_color;
+            }
+            if (consistent) {
+                history.emplace_back(code, mastermind::compute_game_result(secret_code, code));
+                if (r == secret) {
+                    return history.size();
+                }
+            }
+        }
+        return 0;
+    }
+};
+
+
+TEST_F(MastermindDifficultyIndexTest, ShouldMatchReferenceStrategyPlayedGameByGame) {
+    auto index = mastermind::difficulty_index::build(space, 3);
+
+    EXPECT_EQ(index.get_difficulty(0), 1u);
+    for (mastermind::code_space::rank_type r{ 0 }; r < space.size(); r += 7) {
+        EXPECT_EQ(index.get_difficulty(r), play(r)) << "rank " << r;
+    }
+}
+
+TEST_F(MastermindDifficultyIndexTest, ShouldNotDependOnThreadCount) {
+    auto single = mastermind::difficulty_index::build(space, 1);
+    auto parallel = mastermind::difficulty_index::build(space, 8);
+
+    for (mastermind::code_space::rank_type r{ 0 }; r < space.size(); ++r) {
+        ASSERT_EQ(single.get_difficulty(r), parallel.get_difficulty(r));
+    }
+}
+
+TEST_F(MastermindDifficultyIndexTest, ShouldCountAndSampleOnlyCodesOfTheBand) {
+    auto index = mastermind::difficulty_index::build(space, 2);
+    std::mt19937 g{ 1 };
+    mastermind::code_space::rank_type total{ 0 };
+    for (size_t d{ 0 }; d <= index.get_max_difficulty(); ++d) {
+        total += index.count({ static_cast<std::uint8_t>(d), static_cast<std::uint8_t>(d) });
+    }
+
+    EXPECT_EQ(total, space.size());
+    EXPECT_EQ(index.count({ 0, 255 }), space.size());
+    for (int i{ 0 }; i < 200; ++i) {
+        auto rank = index.sample({ 3, 4 }, g);
+        EXPECT_GE(index.get_difficulty(rank), 3u);
+        EXPECT_LE(index.get_difficulty(rank), 4u);
+    }
+    EXPECT_THROW(index.sample({ 5, 2 }, g), mastermind::empty_difficulty_band_error);
+}
+
+TEST_F(MastermindDifficultyIndexTest, ShouldLoadSavedIndex) {
+    auto index = mastermind::difficulty_index::build(space, 2);
+    index.save(TEST_PATH);
+
+    auto loaded = mastermind::difficulty_index::load(TEST_PATH);
+
+    EXPECT_EQ(loaded.get_code_space().size(), space.size());
+    EXPECT_EQ(loaded.get_max_difficulty(), index.get_max_difficulty());
+    for (mastermind::code_space::rank_type r{ 0 }; r < space.size(); ++r) {
+        ASSERT_EQ(loaded.get_difficulty(r), index.get_difficulty(r));
+    }
+}
+
+TEST_F(MastermindDifficultyIndexTest, ShouldSaveRemoveTemporaryFileWhenIndexCannotBeReplaced) {
+    ASSERT_EQ(::mkdir(TEST_PATH.c_str(), 0755), 0);
+
+    EXPECT_THROW(mastermind::difficulty_index::build(space, 1).save(TEST_PATH), mastermind::difficulty_index_error);
+
+    EXPECT_FALSE(std::ifstream{ TEST_PATH + ".tmp" }.good());
+    ::rmdir(TEST_PATH.c_str());
+}
+
+TEST_F(MastermindDifficultyIndexTest, ShouldLoadThrowDifficultyIndexErrorForCorruptedFile) {
+    mastermind::difficulty_index::build(space, 1).save(TEST_PATH);
+    {
+        std::fstream file{ TEST_PATH, std::ios::in | std::ios::out | std::ios::binary };
+        file.seekp(40);
+        file.put(99);
+    }
+
+    EXPECT_THROW(mastermind::difficulty_index::load(TEST_PATH), mastermind::difficulty_index_error);
+}
@@ -0,0 +1,152 @@
+#include "../include/mastermind_engine_snapshot.hpp"
+#include "gmock/gmock.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+class MastermindEngineSnapshotTest : public ::testing::Test {
+public:
+    const std::vector<int> TEST_CORRECT_SOLUTION{ { 1, 2, 3, 4, 5 } };
+    std::string path{ ::testing::TempDir() + "mastermind_engine_snapshot_test_" +
+        ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".bin" };
+
+    MastermindEngineSnapshotTest() { std::remove(path.c_str()); }
+    ~MastermindEngineSnapshotTest() { std::remove(path.c_str()); }
+
+    mastermind::mastermind_engine<int> make_engine(std::vector<int> secret) {
+        return mastermind::mastermind_engine<int>{ [secret](size_t) { return secret; } };
+    }
+
+    mastermind::mastermind_engine<int> make_unused_engine() {
+        return make_engine({});
+    }
+};
+
+
+TEST_F(MastermindEngineSnapshotTest, ShouldRestoreGameInProgress) {
+    auto engine = make_engine(TEST_CORRECT_SOLUTION);
+    engine.start_game({ 5, 8 });
+    engine.check_solution({ 1, 3, 2, 4, 6 });
+
+    mastermind::engine_snapshot_writer<int> writer{};
+    writer.add(engine);
+    std::vector<unsigned char> buffer = writer.serialize();
+    mastermind::engine_snapshot_view<int> view{ buffer.data(), buffer.size() };
+    auto restored = make_unused_engine();
+    view.restore(0, restored);
+
+    ASSERT_EQ(view.size(), 1u);
+    EXPECT_EQ(restored.get_status(), mastermind::game_status::IN_GAME);
+    EXPECT_EQ(restored.get_tries_left(), 7u);
+    EXPECT_EQ(restored.get_correct_solution().value().get(), TEST_CORRECT_SOLUTION);
+
+    auto result = restored.check_solution(TEST_CORRECT_SOLUTION);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result.value().valid);
+    EXPECT_EQ(restored.get_status(), mastermind::game_status::ENDED);
+}
+
+TEST_F(MastermindEngineSnapshotTest, ShouldRestoreBatchOfSessionsFromFile) {
+    const size_t sessions{ 10000 };
+    mastermind::engine_snapshot_writer<int> writer{};
+    for (size_t i{ 0 }; i < sessions; ++i) {
+        auto engine = make_engine({ static_cast<int>(i), -1, -2 });
+        if (i % 3 != 0) {
+            engine.start_game({ 3, i % 7 + 2 });
+        }
+        if (i % 3 == 2) {
+            engine.check_solution({ static_cast<int>(i), -2, -1 });
+        }
+        writer.add(engine);
+    }
+    writer.save(path);
+
+    mastermind::engine_snapshot_file<int> file{ path };
+    const auto& view = file.view();
+
+    ASSERT_EQ(view.size(), sessions);
+    for (size_t i{ 0 }; i < sessions; ++i) {
+        auto restored = make_unused_engine();
+        view.restore(i, restored);
+        if (i % 3 == 0) {
+            EXPECT_EQ(restored.get_status(), mastermind::game_status::NOT_INITIALIZED);
+            EXPECT_FALSE(restored.get_correct_solution().has_value());
+            continue;
+        }
+        EXPECT_EQ(restored.get_status(), mastermind::game_status::IN_GAME);
+        EXPECT_EQ(restored.get_tries_left(), i % 7 + 2 - (i % 3 == 2 ? 1 : 0));
+        ASSERT_EQ(view.get_code_size(i), 3u);
+        EXPECT_EQ(view.get_code_pattern(i)[0], static_cast<int>(i));
+    }
+}
+
+TEST_F(MastermindEngineSnapshotTest, ShouldRestoreCodeRuleOfSession) {
+    mastermind::mastermind_engine<int> engine{ [](size_t) { return std::vector<int>{ 1, 1, 2 }; }, mastermind::code_rule::REPEATED_VALUES };
+    engine.start_game({ 3, 8 });
+    mastermind::engine_snapshot_writer<int> writer{};
+    writer.add(engine);
+    std::vector<unsigned char> buffer = writer.serialize();
+    mastermind::engine_snapshot_view<int> view{ buffer.data(), buffer.size() };
+
+    mastermind::mastermind_engine<int> restored{ [](size_t) { return std::vector<int>{}; }, mastermind::code_rule::REPEATED_VALUES };
+    view.restore(0, restored);
+    auto other_rule = make_unused_engine();
+
+    EXPECT_EQ(view.get_state(0).rule, mastermind::code_rule::REPEATED_VALUES);
+    EXPECT_EQ(restored.get_tries_left(), 8u);
+    EXPECT_THROW(view.restore(0, other_rule), mastermind::code_rule_mismatch_error);
+}
+
+TEST_F(MastermindEngineSnapshotTest, ShouldRejectSnapshotOfDifferentValueSize) {
+    mastermind::engine_snapshot_writer<int> writer{};
+    writer.add(make_unused_engine());
+    std::vector<unsigned char> buffer = writer.serialize();
+
+    EXPECT_THROW((mastermind::engine_snapshot_view<long long>{ buffer.data(), buffer.size() }), mastermind::engine_snapshot_error);
+}
+
+TEST_F(MastermindEngineSnapshotTest, ShouldRejectTruncatedSnapshot) {
+    auto engine = make_engine(TEST_CORRECT_SOLUTION);
+    engine.start_game({ 5, 8 });
+    mastermind::engine_snapshot_writer<int> writer{};
+    writer.add(engine);
+    std::vector<unsigned char> buffer = writer.serialize();
+
+    EXPECT_THROW((mastermind::engine_snapshot_view<int>{ buffer.data(), buffer.size() - 1 }), mastermind::engine_snapshot_error);
+}
+
+TEST_F(MastermindEngineSnapshotTest, ShouldRejectSessionInGameWithoutTriesLeft) {
+    auto engine = make_engine(TEST_CORRECT_SOLUTION);
+    engine.start_game({ 5, 8 });
+    mastermind::engine_snapshot_writer<int> writer{};
+    writer.add(engine);
+    std::vector<unsigned char> buffer = writer.serialize();
+    mastermind::engine_snapshot_entry entry{};
+    std::memcpy(&entry, buffer.data() + sizeof(mastermind::engine_snapshot_header), sizeof(entry));
+    entry.tries_left = 0;
+    std::memcpy(buffer.data() + sizeof(mastermind::engine_snapshot_header), &entry, sizeof(entry));
+
+    EXPECT_THROW((mastermind::engine_snapshot_view<int>{ buffer.data(), buffer.size() }), mastermind::engine_snapshot_error);
+}
+
+TEST_F(MastermindEngineSnapshotTest, ShouldSaveRemoveTemporaryFileWhenSnapshotCannotBeReplaced) {
+    ASSERT_EQ(::mkdir(path.c_str(), 0755), 0);
+    auto engine = make_engine(TEST_CORRECT_SOLUTION);
+    engine.start_game({ 5, 8 });
+    mastermind::engine_snapshot_writer<int> writer{};
+    writer.add(engine);
+
+    EXPECT_THROW(writer.save(path), mastermind::engine_snapshot_error);
+
+    EXPECT_FALSE(std::ifstream{ path + ".tmp" }.good());
+    ::rmdir(path.c_str());
+}
+
+TEST_F(MastermindEngineSnapshotTest, ShouldRejectFileWithoutHeader) {
+    std::ofstream{ path } << "definitely not an engine snapshot";
+
+    EXPECT_THROW(mastermind::engine_snapshot_file<int>{ path }, mastermind::engine_snapshot_error);
+}
@@ -263,3 +263,77 @@ TEST_F(MastermindEngineTest, ShouldTriesLeftDecrementAfterIncorrectSolution) {
 TEST_F(MastermindEngineTest, ShouldStartGameThrowZeroMaxTriesValueErrorIfMaxTriesIsZero) {
     ASSERT_THROW(engine.start_game({ PATTERN_SIZE, 0 }), mastermind::zero_max_tries_value_error);
 }
+
+TEST_F(MastermindEngineTest, ShouldRestoreStateSavedFromAnotherEngine) {
+    engine.start_game({ PATTERN_SIZE, 8 });
+    engine.check_solution(std::vector<int>{ { 1, 3, 4, 6, 5 } });
+    mastermind::mastermind_engine<int> restored{ test_generator };
+
+    restored.restore_state(engine.save_state());
+
+    EXPECT_EQ(restored.get_status(), mastermind::game_status::IN_GAME);
+    EXPECT_EQ(restored.get_tries_left(), 7u);
+    ASSERT_TRUE(restored.get_correct_solution().has_value());
+    EXPECT_EQ(restored.get_correct_solution().value().get(), TEST_CORRECT_SOLUTION);
+}
+
+TEST_F(MastermindEngineTest, ShouldRestoreStateThrowIndistinctValuesErrorIfCodePatternHasRepeatedValues) {
+    ASSERT_THROW(engine.restore_state({ mastermind::game_status::IN_GAME, { 1, 1, 2 }, 3, { false, 0, 0 } }),
+        mastermind::indistinct_values_error);
+}
+
+TEST_F(MastermindEngineTest, ShouldRestoreStateThrowZeroMaxTriesValueErrorForGameInProgressWithoutTries) {
+    ASSERT_THROW(engine.restore_state({ mastermind::game_status::IN_GAME, TEST_CORRECT_SOLUTION, 0, { false, 0, 0 } }),
+        mastermind::zero_max_tries_value_error);
+}
+
+TEST_F(MastermindEngineTest, ShouldAcceptAndScoreRepeatedValuesWhenAllowed) {
+    mastermind::mastermind_engine<int> repeats_engine{ [](size_t) { return std::vector<int>{ 1, 1, 2, 2 }; },
+        mastermind::code_rule::REPEATED_VALUES };
+    repeats_engine.start_game({ 4, 8 });
+
+    auto result = repeats_engine.check_solution(std::vector<int>{ 1, 2, 1, 1 });
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_FALSE(result.value().valid);
+    EXPECT_EQ(result.value().pegs_in_right_place, 1u);
+    EXPECT_EQ(result.value().pegs_in_right_color, 2u);
+    EXPECT_TRUE(repeats_engine.check_solution(std::vector<int>{ 1, 1, 2, 2 }).value().valid);
+}
+
+TEST_F(MastermindEngineTest, ShouldRestoreStateThrowCodeRuleMismatchErrorForStateOfOtherRule) {
+    mastermind::mastermind_engine<int> repeats_engine{ [](size_t) { return std::vector<int>{ 1, 2, 3 }; },
+        mastermind::code_rule::REPEATED_VALUES };
+    repeats_engine.start_game({ 3, 8 });
+
+    ASSERT_THROW(engine.restore_state(repeats_engine.save_state()), mastermind::code_rule_mismatch_error);
+}
+
+TEST_F(MastermindEngineTest, ShouldRejectRepeatedValuesByDefault) {
+    engine.start_game({ PATTERN_SIZE, 8 });
+
+    EXPECT_EQ(engine.get_code_rule(), mastermind::code_rule::DISTINCT_VALUES);
+    ASSERT_THROW(engine.check_solution(std::vector<int>{ { 1, 1, 2, 3, 4 } }), mastermind::indistinct_values_error);
+}
+
+TEST_F(MastermindEngineTest, ShouldCheckSolutionsScoreEachRequestLikeCheckSolution) {
+    engine.start_game({ PATTERN_SIZE, 8 });
+    mastermind::mastermind_engine<int> not_started{ [](size_t) { return std::vector<int>{}; } };
+    const std::vector<int> guess{ { 2, 1, 3, 5, 9 } };
+    const std::vector<int> too_short{ { 1, 2 } };
+    std::vector<mastermind::mastermind_engine<int>::check_solution_request> requests{
+        { &engine, &guess, std::nullopt, nullptr },
+        { &engine, &too_short, std::nullopt, nullptr },
+        { &not_started, &guess, std::nullopt, nullptr },
+        { &engine, &TEST_CORRECT_SOLUTION, std::nullopt, nullptr } };
+
+    mastermind::mastermind_engine<int>::check_solutions(requests.data(), requests.size());
+
+    ASSERT_TRUE(requests[0].result.has_value());
+    EXPECT_EQ(requests[0].result.value().pegs_in_right_place, 1u);
+    EXPECT_EQ(requests[0].result.value().pegs_in_right_color, 3u);
+    EXPECT_THROW(std::rethrow_exception(requests[1].error), mastermind::incorrect_code_size_error);
+    EXPECT_FALSE(requests[2].result.has_value());
+    EXPECT_TRUE(requests[3].result.value().valid);
+    EXPECT_EQ(engine.get_status(), mastermind::game_status::ENDED);
+}
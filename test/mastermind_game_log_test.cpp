@@ -0,0 +1,145 @@
+#include "../include/mastermind_basic_code_pattern_generator.hpp"
+#include "../include/mastermind_game_log.hpp"
+#include "gmock/gmock.h"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <numeric>
+
+
+class MastermindGameLogTest : public ::testing::Test {
+public:
+    const size_t CODE_SIZE{ 5 };
+    std::string path{ ::testing::TempDir() + "mastermind_game_log_test_" +
+        ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".bin" };
+
+    MastermindGameLogTest() { std::remove(path.c_str()); }
+    ~MastermindGameLogTest() { std::remove(path.c_str()); }
+
+    size_t record_games(mastermind::game_log_writer& writer, size_t games) {
+        std::vector<int> code_set(10);
+        std::iota(code_set.begin(), code_set.end(), 0);
+        mastermind::basic_code_pattern_generator<int> generator{ code_set };
+        mastermind::game_log_recorder<int> recorder{ writer };
+        size_t guesses{ 0 };
+
+        for (size_t game{ 0 }; game < games; ++game) {
+            std::vector<int> secret = generator(CODE_SIZE);
+            recorder.on_game_started({ CODE_SIZE, 4 });
+            for (size_t turn{ 0 }; turn < 3; ++turn) {
+                std::vector<int> guess = generator(CODE_SIZE);
+                recorder.on_guess_scored(guess, mastermind::compute_game_result(secret, guess));
+                ++guesses;
+            }
+            recorder.on_guess_scored(secret, mastermind::compute_game_result(secret, secret));
+            recorder.on_game_ended(secret);
+            ++guesses;
+        }
+        return guesses;
+    }
+};
+
+
+TEST_F(MastermindGameLogTest, ShouldReplayRecordedGamesWithoutMismatches) {
+    size_t guesses{ 0 };
+    {
+        mastermind::game_log_writer writer{ path };
+        guesses = record_games(writer, 5000);
+    }
+
+    mastermind::game_log_reader reader{ path };
+    auto result = mastermind::replay_game_log(reader.records(), reader.size(), 4);
+
+    EXPECT_EQ(reader.size(), 5000u * 5);
+    EXPECT_EQ(result.games, 5000u);
+    EXPECT_EQ(result.guesses, guesses);
+    EXPECT_EQ(result.mismatches, 0u);
+    EXPECT_EQ(result.malformed_records, 0u);
+}
+
+TEST_F(MastermindGameLogTest, ShouldAppendGamesToExistingLog) {
+    {
+        mastermind::game_log_writer writer{ path };
+        record_games(writer, 3);
+    }
+    {
+        mastermind::game_log_writer writer{ path };
+        record_games(writer, 2);
+    }
+
+    mastermind::game_log_reader reader{ path };
+    EXPECT_EQ(mastermind::replay_game_log(reader.records(), reader.size(), 2).games, 5u);
+}
+
+TEST_F(MastermindGameLogTest, ShouldReplayDetectTamperedFeedback) {
+    {
+        mastermind::game_log_writer writer{ path };
+        mastermind::game_log_recorder<int> recorder{ writer };
+        recorder.on_game_started({ 3, 4 });
+        recorder.on_guess_scored({ 1, 2, 3 }, { false, 0, 3 });
+        recorder.on_guess_scored({ 3, 1, 2 }, { true, 3, 0 });
+        recorder.on_game_ended({ 3, 1, 2 });
+    }
+
+    mastermind::game_log_reader reader{ path };
+    auto result = mastermind::replay_game_log(reader.records(), reader.size(), 1);
+
+    EXPECT_EQ(result.guesses, 2u);
+    EXPECT_EQ(result.mismatches, 0u);
+
+    std::vector<mastermind::game_log_record> records{ reader.records(), reader.records() + reader.size() };
+    records[1].pegs_in_right_place = 1;
+    EXPECT_EQ(mastermind::replay_game_log(records.data(), records.size(), 1).mismatches, 1u);
+}
+
+TEST_F(MastermindGameLogTest, ShouldRecorderSkipGamesThatDoNotFitInRecords) {
+    {
+        mastermind::game_log_writer writer{ path };
+        mastermind::game_log_recorder<int> recorder{ writer };
+        recorder.on_game_started({ 3, 4 });
+        EXPECT_NO_THROW(recorder.on_guess_scored({ 1, 2, 300 }, { false, 0, 0 }));
+        recorder.on_guess_scored({ 3, 1, 2 }, { true, 3, 0 });
+        recorder.on_game_ended({ 3, 1, 2 });
+
+        recorder.on_game_started({ 30, 4 });
+        recorder.on_game_ended(std::vector<int>(30, 1));
+
+        recorder.on_game_started({ 3, 4 });
+        recorder.on_guess_scored({ 3, 1, 2 }, { true, 3, 0 });
+        recorder.on_game_ended({ 3, 1, 2 });
+
+        EXPECT_EQ(recorder.get_skipped_games(), 2u);
+        EXPECT_EQ(recorder.get_last_skip_reason(), "code of 30 values does not fit in a record");
+    }
+
+    mastermind::game_log_reader reader{ path };
+    auto result = mastermind::replay_game_log(reader.records(), reader.size(), 1);
+    EXPECT_EQ(result.games, 1u);
+    EXPECT_EQ(result.malformed_records, 0u);
+}
+
+TEST_F(MastermindGameLogTest, ShouldRecorderSkipGamesWithMaxTriesNotFittingRecord) {
+    const std::uint64_t max_tries{ std::numeric_limits<std::uint32_t>::max() };
+    if (max_tries == std::numeric_limits<size_t>::max()) {
+        GTEST_SKIP();
+    }
+    {
+        mastermind::game_log_writer writer{ path };
+        mastermind::game_log_recorder<int> recorder{ writer };
+        recorder.on_game_started({ 3, static_cast<size_t>(max_tries + 1) });
+        recorder.on_guess_scored({ 3, 1, 2 }, { true, 3, 0 });
+        recorder.on_game_ended({ 3, 1, 2 });
+
+        EXPECT_EQ(recorder.get_skipped_games(), 1u);
+    }
+
+    mastermind::game_log_reader reader{ path };
+    EXPECT_EQ(reader.size(), 0u);
+}
+
+TEST_F(MastermindGameLogTest, ShouldReaderRejectFileWithoutHeader) {
+    std::ofstream{ path } << "definitely not a game log";
+
+    EXPECT_THROW(mastermind::game_log_reader{ path }, mastermind::game_log_error);
+}
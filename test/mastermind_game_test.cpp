@@ -27,6 +27,13 @@ public:
     MOCK_METHOD0(ask_play_again, bool());
 };
 
+class MastermindGameObserverMock : public mastermind::mastermind_game_observer<int> {
+public:
+    MOCK_METHOD1(on_game_started, void(mastermind::game_start_params));
+    MOCK_METHOD2(on_guess_scored, void(const std::vector<int>&, mastermind::game_result));
+    MOCK_METHOD1(on_game_ended, void(const std::vector<int>&));
+};
+
 class MastermindEngineHelperMock {
 public:
     MOCK_METHOD1(constructor, void(std::function<std::vector<int>(size_t)>));
@@ -276,3 +283,20 @@ TEST_F(MastermindGameTest, ShouldAskForSolutionAgainIfGameIsNotEnded) {
     EXPECT_CALL(ui_mock, ask_for_solution()).Times(Exactly(2));
     game.run();
 }
+
+TEST_F(MastermindGameTest, ShouldNotifyObserverAboutStartGuessesAndEndOfGame) {
+    EXPECT_CALL(me_helper, get_status())
+        .WillOnce(Return(mastermind::game_status::IN_GAME))
+        .WillRepeatedly(Return(mastermind::game_status::ENDED));
+    ON_CALL(ui_mock, ask_for_solution()).WillByDefault(Return(TEST_CORRECT_SOLUTION));
+    ON_CALL(me_helper, check_solution(_)).WillByDefault(Return(TEST_POSITIVE_GAME_RESULT));
+    ON_CALL(me_helper, get_correct_solution()).WillByDefault(Return(std::cref(TEST_CORRECT_SOLUTION)));
+    ::testing::StrictMock<MastermindGameObserverMock> observer{};
+    mastermind::mastermind_game<MastermindEngineMock> game{ ui_mock, test_generator };
+    game.set_observer(&observer);
+
+    Expectation started = EXPECT_CALL(observer, on_game_started(StartGameParamsEquals(TEST_PARAMS)));
+    Expectation scored = EXPECT_CALL(observer, on_guess_scored(TEST_CORRECT_SOLUTION, GameResultEquals(TEST_POSITIVE_GAME_RESULT))).After(started);
+    EXPECT_CALL(observer, on_game_ended(TEST_CORRECT_SOLUTION)).After(scored);
+    game.run();
+}
@@ -0,0 +1,116 @@
+#include "../include/mastermind_engine.hpp"
+#include "../include/mastermind_metrics.hpp"
+#include "gmock/gmock.h"
+#include <thread>
+
+
+class MastermindMetricsTest : public ::testing::Test {
+public:
+    const std::vector<int> TEST_CORRECT_SOLUTION{ { 1, 2, 3, 4, 5 } };
+    mastermind::metrics_snapshot before{ mastermind::metrics_registry::instance().snapshot() };
+
+    std::uint64_t delta(mastermind::metric_counter counter) const {
+        return mastermind::metrics_registry::instance().snapshot().get(counter) - before.get(counter);
+    }
+
+    std::uint64_t delta(mastermind::metric_histogram histogram) const {
+        return mastermind::metrics_registry::instance().snapshot().get(histogram).count - before.get(histogram).count;
+    }
+
+    // What a delta should be, given that nothing is recorded with metrics compiled out.
+    static std::uint64_t counted(std::uint64_t value) {
+        return mastermind::metrics_enabled ? value : 0;
+    }
+};
+
+
+TEST_F(MastermindMetricsTest, ShouldLogLinearBucketBoundValueWithinOneEighth) {
+    using buckets = mastermind::log_linear_buckets;
+
+    for (std::uint64_t value : { 0ull, 1ull, 7ull, 8ull, 9ull, 100ull, 1000ull, 123456789ull, 1ull << 40 }) {
+        std::uint64_t upper = buckets::upper_bound(buckets::index(value));
+        EXPECT_GE(upper, value);
+        EXPECT_LE(upper - value, value / 8);
+    }
+    EXPECT_LT(buckets::index(UINT64_MAX), buckets::count);
+}
+
+TEST_F(MastermindMetricsTest, ShouldHistogramPercentileReturnBucketUpperBound) {
+    mastermind::histogram_snapshot h{};
+    for (std::uint64_t value : { 1, 2, 3, 4, 1000 }) {
+        ++h.buckets[mastermind::log_linear_buckets::index(value)];
+        ++h.count;
+        h.sum += value;
+    }
+
+    EXPECT_EQ(h.percentile(0.5), 3u);
+    EXPECT_GE(h.percentile(1.0), 1000u);
+}
+
+TEST_F(MastermindMetricsTest, ShouldEngineCountGamesGuessesAndLatencies) {
+    mastermind::mastermind_engine<int> engine{ [this](size_t) { return TEST_CORRECT_SOLUTION; } };
+
+    engine.start_game({ 5, 8 });
+    engine.check_solution(std::vector<int>{ { 1, 3, 4, 6, 5 } });
+    engine.check_solution(TEST_CORRECT_SOLUTION);
+
+    EXPECT_EQ(delta(mastermind::metric_counter::GAMES_STARTED), counted(1));
+    EXPECT_EQ(delta(mastermind::metric_counter::GUESSES_SCORED), counted(2));
+    EXPECT_EQ(delta(mastermind::metric_counter::GAMES_WON), counted(1));
+    EXPECT_EQ(delta(mastermind::metric_counter::GAMES_LOST), counted(0));
+    EXPECT_EQ(delta(mastermind::metric_histogram::START_GAME_LATENCY), counted(1));
+    EXPECT_EQ(delta(mastermind::metric_histogram::CHECK_SOLUTION_LATENCY), counted(2));
+}
+
+TEST_F(MastermindMetricsTest, ShouldBatchedCheckSolutionsRecordLatencyPerRequest) {
+    mastermind::mastermind_engine<int> engine{ [this](size_t) { return TEST_CORRECT_SOLUTION; } };
+    mastermind::mastermind_engine<int> other_engine{ [this](size_t) { return TEST_CORRECT_SOLUTION; } };
+    engine.start_game({ 5, 8 });
+    other_engine.start_game({ 5, 8 });
+    const std::vector<int> guess{ { 1, 3, 4, 6, 5 } };
+    std::vector<mastermind::mastermind_engine<int>::check_solution_request> requests{
+        { &engine, &guess, std::nullopt, nullptr }, { &other_engine, &TEST_CORRECT_SOLUTION, std::nullopt, nullptr } };
+
+    mastermind::mastermind_engine<int>::check_solutions(requests.data(), requests.size());
+
+    EXPECT_EQ(delta(mastermind::metric_histogram::CHECK_SOLUTION_LATENCY), counted(2));
+}
+
+TEST_F(MastermindMetricsTest, ShouldEngineCountLostGamesAndValidationFailures) {
+    mastermind::mastermind_engine<int> engine{ [this](size_t) { return TEST_CORRECT_SOLUTION; } };
+
+    EXPECT_THROW(engine.start_game({ 5, 0 }), mastermind::zero_max_tries_value_error);
+    engine.start_game({ 5, 1 });
+    EXPECT_THROW(engine.check_solution(std::vector<int>{ { 1, 2 } }), mastermind::incorrect_code_size_error);
+    EXPECT_THROW(engine.check_solution(std::vector<int>{ { 1, 1, 2, 3, 4 } }), mastermind::indistinct_values_error);
+    engine.check_solution(std::vector<int>{ { 5, 4, 3, 2, 1 } });
+
+    EXPECT_EQ(delta(mastermind::metric_counter::ZERO_MAX_TRIES_ERRORS), counted(1));
+    EXPECT_EQ(delta(mastermind::metric_counter::INCORRECT_CODE_SIZE_ERRORS), counted(1));
+    EXPECT_EQ(delta(mastermind::metric_counter::INDISTINCT_VALUES_ERRORS), counted(1));
+    EXPECT_EQ(delta(mastermind::metric_counter::GAMES_LOST), counted(1));
+}
+
+TEST_F(MastermindMetricsTest, ShouldSnapshotMergeCountersOfFinishedThreads) {
+    std::vector<std::thread> threads{};
+    for (size_t t{ 0 }; t < 4; ++t) {
+        threads.emplace_back([]() {
+            for (size_t i{ 0 }; i < 1000; ++i) {
+                mastermind::count_metric(mastermind::metric_counter::GAME_LOOP_TURNS);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(delta(mastermind::metric_counter::GAME_LOOP_TURNS), counted(4000));
+}
+
+TEST_F(MastermindMetricsTest, ShouldTextSnapshotListEveryMetric) {
+    std::string text = mastermind::metrics_registry::instance().snapshot().to_text();
+
+    EXPECT_THAT(text, ::testing::HasSubstr("mastermind_games_started_total "));
+    EXPECT_THAT(text, ::testing::HasSubstr("mastermind_check_solution_latency_ns{quantile=\"0.99\"} "));
+    EXPECT_THAT(text, ::testing::HasSubstr("mastermind_start_game_latency_ns_count "));
+}
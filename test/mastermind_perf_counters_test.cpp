@@ -0,0 +1,49 @@
+#include "../include/mastermind_perf_counters.hpp"
+#include "gmock/gmock.h"
+#include <sstream>
+
+
+namespace {
+
+    int instrumented_sum(int a, int b) {
+        MASTERMIND_PERF_SCOPE("test.instrumented_sum");
+        return a + b;
+    }
+
+}
+
+
+TEST(MastermindPerfCountersTest, ShouldCounterValuesDifferenceBeComputedPerCounter) {
+    mastermind::perf_counter_values begin{ 10, 20, 3, 4 };
+    mastermind::perf_counter_values end{ 110, 420, 5, 8 };
+
+    auto delta = end - begin;
+
+    EXPECT_EQ(delta.cycles, 100u);
+    EXPECT_EQ(delta.instructions, 400u);
+    EXPECT_EQ(delta.cache_misses, 2u);
+    EXPECT_EQ(delta.branch_misses, 4u);
+}
+
+TEST(MastermindPerfCountersTest, ShouldReportPerOperationFigures) {
+    std::ostringstream os{};
+
+    mastermind::write_perf_report(os, { { "engine.compute_game_result", 4, { 400, 800, 8, 4 } } });
+
+    EXPECT_THAT(os.str(), ::testing::HasSubstr("engine.compute_game_result 4 100 200 2 2 1"));
+}
+
+TEST(MastermindPerfCountersTest, ShouldPerfScopeRecordCallsOnlyWhenEnabled) {
+    EXPECT_EQ(instrumented_sum(2, 3), 5);
+
+    auto stats = mastermind::perf_registry::instance().snapshot();
+    auto it = std::find_if(stats.begin(), stats.end(), [](const auto& s) { return s.name == "test.instrumented_sum"; });
+
+    if (mastermind::perf_counters_enabled) {
+        ASSERT_NE(it, stats.end());
+        EXPECT_GE(it->calls, 1u);
+    }
+    else {
+        EXPECT_EQ(it, stats.end());
+    }
+}
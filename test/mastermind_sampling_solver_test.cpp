@@ -0,0 +1,86 @@
+#include "../include/mastermind_engine.hpp"
+#include "../include/mastermind_sampling_solver.hpp"
+#include "gmock/gmock.h"
+#include <numeric>
+
+
+class MastermindSamplingSolverTest : public ::testing::Test {
+public:
+    const size_t CODE_SIZE{ 5 };
+    const size_t SAMPLE_SIZE{ 32 };
+    const std::uint_fast32_t SEED{ 12345 };
+    const std::vector<int> TEST_CORRECT_SOLUTION{ { 3, 9, 1, 6, 4 } };
+    std::vector<int> code_set;
+
+    MastermindSamplingSolverTest() : code_set(10) {
+        std::iota(code_set.begin(), code_set.end(), 0);
+    }
+};
+
+
+TEST_F(MastermindSamplingSolverTest, ShouldThrowCodeSetTooSmallErrorIfCodeSizeExceedsCodeSet) {
+    EXPECT_THROW((mastermind::sampling_solver<int>{ { 1, 2, 3 }, { 4, 8 } }), mastermind::code_set_too_small_error);
+}
+
+TEST_F(MastermindSamplingSolverTest, ShouldThrowIndistinctValuesErrorForCodeSetWithRepeatedElements) {
+    EXPECT_THROW((mastermind::sampling_solver<int>{ { 1, 2, 2, 3 }, { 2, 8 } }), mastermind::indistinct_values_error);
+}
+
+TEST_F(MastermindSamplingSolverTest, ShouldNextGuessReturnDistinctValuesFromCodeSet) {
+    mastermind::sampling_solver<int> solver{ code_set, { CODE_SIZE, 8 }, SAMPLE_SIZE, SEED };
+
+    auto guess = solver.next_guess();
+
+    ASSERT_EQ(guess.size(), CODE_SIZE);
+    EXPECT_TRUE(mastermind::are_all_values_different(guess));
+    for (int value : guess) {
+        EXPECT_THAT(code_set, ::testing::Contains(value));
+    }
+}
+
+TEST_F(MastermindSamplingSolverTest, ShouldSampleNeverExceedMaxSampleSize) {
+    mastermind::sampling_solver<int> solver{ code_set, { CODE_SIZE, 8 }, SAMPLE_SIZE, SEED };
+
+    solver.next_guess();
+
+    EXPECT_EQ(solver.get_sample_size(), SAMPLE_SIZE);
+    EXPECT_EQ(solver.get_max_sample_size(), SAMPLE_SIZE);
+}
+
+TEST_F(MastermindSamplingSolverTest, ShouldAddFeedbackThrowIncorrectCodeSizeErrorForInvalidSizedGuess) {
+    mastermind::sampling_solver<int> solver{ code_set, { CODE_SIZE, 8 }, SAMPLE_SIZE, SEED };
+
+    EXPECT_THROW(solver.add_feedback({ 1, 2, 3 }, { false, 0, 0 }), mastermind::incorrect_code_size_error);
+}
+
+TEST_F(MastermindSamplingSolverTest, ShouldAddFeedbackThrowValueNotInCodeSetErrorForUnknownValue) {
+    mastermind::sampling_solver<int> solver{ code_set, { CODE_SIZE, 8 }, SAMPLE_SIZE, SEED };
+
+    EXPECT_THROW(solver.add_feedback({ 1, 2, 3, 4, 42 }, { false, 0, 0 }), mastermind::value_not_in_code_set_error);
+}
+
+TEST_F(MastermindSamplingSolverTest, ShouldNextGuessBeConsistentWithPreviousFeedback) {
+    mastermind::sampling_solver<int> solver{ code_set, { CODE_SIZE, 8 }, SAMPLE_SIZE, SEED };
+    std::vector<int> first_guess{ { 0, 1, 2, 3, 4 } };
+
+    solver.add_feedback(first_guess, mastermind::compute_game_result(TEST_CORRECT_SOLUTION, first_guess));
+    auto guess = solver.next_guess();
+
+    EXPECT_TRUE(solver.is_consistent(guess));
+    EXPECT_TRUE(solver.is_consistent(TEST_CORRECT_SOLUTION));
+    EXPECT_FALSE(solver.is_consistent(first_guess));
+}
+
+TEST_F(MastermindSamplingSolverTest, ShouldSolveTheGameAgainstTheEngine) {
+    mastermind::sampling_solver<int> solver{ code_set, { CODE_SIZE, 12 }, SAMPLE_SIZE, SEED };
+    mastermind::mastermind_engine<int> engine{ [this](size_t) { return TEST_CORRECT_SOLUTION; } };
+    engine.start_game({ CODE_SIZE, 12 });
+
+    while (engine.get_status() == mastermind::game_status::IN_GAME) {
+        auto guess = solver.next_guess();
+        auto result = engine.check_solution(guess);
+        solver.add_feedback(guess, result.value());
+    }
+
+    EXPECT_TRUE(engine.check_solution(TEST_CORRECT_SOLUTION).value().valid);
+}
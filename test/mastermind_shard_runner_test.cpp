@@ -0,0 +1,127 @@
+#include "../include/mastermind_shard_runner.hpp"
+#include "gmock/gmock.h"
+#include <stdexcept>
+
+
+class MastermindShardRunnerTest : public ::testing::Test {
+public:
+    const std::uint64_t JOB_KEY{ 0x5eed };
+    const std::uint64_t SPACE_SIZE{ 10007 };
+    const size_t WIDTH{ 3 };
+    const mastermind::shard_runner_options OPTIONS{ 8, 3, 100 };
+    std::string directory{ ::testing::TempDir() + "mastermind_shard_runner_test_" + std::to_string(::getpid()) + "_" +
+        ::testing::UnitTest::GetInstance()->current_test_info()->name() };
+
+    ~MastermindShardRunnerTest() {
+        for (size_t shard{ 0 }; shard < OPTIONS.shards; ++shard) {
+            std::remove((directory + "/shard-" + std::to_string(shard) + ".ckpt").c_str());
+        }
+        ::rmdir(directory.c_str());
+    }
+
+    static void analysis(std::uint64_t first, std::uint64_t last, std::uint64_t* accumulators) {
+        for (std::uint64_t r{ first }; r < last; ++r) {
+            accumulators[0] += 1;
+            accumulators[1] += r;
+            accumulators[2] += (r % 7 == 0) ? 1 : 0;
+        }
+    }
+
+    std::vector<std::uint64_t> expected() const {
+        std::vector<std::uint64_t> totals(WIDTH, 0);
+        analysis(0, SPACE_SIZE, totals.data());
+        return totals;
+    }
+};
+
+
+TEST_F(MastermindShardRunnerTest, ShouldMergeShardsIntoSameResultAsSingleRun) {
+    mastermind::shard_runner runner{ directory, JOB_KEY, SPACE_SIZE, WIDTH, OPTIONS };
+
+    EXPECT_EQ(runner.run(analysis), expected());
+    EXPECT_EQ(runner.merge(), expected());
+}
+
+TEST_F(MastermindShardRunnerTest, ShouldResumeFailedShardFromItsCheckpoint) {
+    const std::uint64_t failing_rank{ 5000 };
+    mastermind::shard_runner runner{ directory, JOB_KEY, SPACE_SIZE, WIDTH, OPTIONS };
+
+    EXPECT_THROW(runner.run([&](std::uint64_t first, std::uint64_t last, std::uint64_t* accumulators) {
+        if (first <= failing_rank && failing_rank < last) {
+            throw std::runtime_error{ "killed" };
+        }
+        analysis(first, last, accumulators);
+    }), mastermind::shard_runner_error);
+
+    std::vector<mastermind::shard_checkpoint> checkpoints{};
+    for (size_t shard{ 0 }; shard < runner.get_shard_count(); ++shard) {
+        checkpoints.push_back(runner.load(shard));
+    }
+    auto failed = std::find_if(checkpoints.begin(), checkpoints.end(), [](const auto& c) { return !c.is_complete(); });
+    ASSERT_NE(failed, checkpoints.end());
+    EXPECT_GT(failed->next, failed->first);
+    EXPECT_LE(failed->next, failing_rank);
+    EXPECT_EQ(std::count_if(checkpoints.begin(), checkpoints.end(), [](const auto& c) { return !c.is_complete(); }), 1);
+
+    const std::uint64_t resume_from = failed->next;
+    auto result = runner.run([&](std::uint64_t first, std::uint64_t last, std::uint64_t* accumulators) {
+        if (first < resume_from || last > failed->last) {
+            throw std::runtime_error{ "finished ranks analysed again" };
+        }
+        analysis(first, last, accumulators);
+    });
+
+    EXPECT_EQ(result, expected());
+}
+
+TEST_F(MastermindShardRunnerTest, ShouldRejectCheckpointsOfAnotherJob) {
+    mastermind::shard_runner{ directory, JOB_KEY, SPACE_SIZE, WIDTH, OPTIONS }.run(analysis);
+    mastermind::shard_runner other{ directory, JOB_KEY + 1, SPACE_SIZE, WIDTH, OPTIONS };
+
+    EXPECT_THROW(other.merge(), mastermind::shard_runner_error);
+}
+
+TEST_F(MastermindShardRunnerTest, ShouldNotReapChildrenItDidNotFork) {
+    std::fflush(nullptr);
+    pid_t other = ::fork();
+    if (other == 0) {
+        ::_exit(7);
+    }
+    ASSERT_GT(other, 0);
+    mastermind::shard_runner runner{ directory, JOB_KEY, SPACE_SIZE, WIDTH, OPTIONS };
+
+    EXPECT_EQ(runner.run(analysis), expected());
+
+    int status{ 0 };
+    ASSERT_EQ(::waitpid(other, &status, 0), other);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 7);
+}
+
+TEST_F(MastermindShardRunnerTest, ShouldMergeThrowForIncompleteShards) {
+    mastermind::shard_runner runner{ directory, JOB_KEY, SPACE_SIZE, WIDTH, OPTIONS };
+
+    EXPECT_THROW(runner.merge(), mastermind::shard_runner_error);
+}
+
+TEST(MastermindShardCheckpointTest, ShouldSerializeLittleEndianAndParseBack) {
+    mastermind::shard_checkpoint checkpoint{ 1, 2, 3, 4, 5, 9, 7, { 0x0102030405060708ULL, 42 } };
+
+    std::string bytes = checkpoint.serialize();
+    mastermind::shard_checkpoint parsed = mastermind::shard_checkpoint::parse(bytes);
+
+    EXPECT_EQ(static_cast<unsigned char>(bytes[8]), 1u);
+    EXPECT_EQ(static_cast<unsigned char>(bytes[12]), 2u);
+    EXPECT_EQ(parsed.job_key, 1u);
+    EXPECT_EQ(parsed.shard, 3u);
+    EXPECT_EQ(parsed.next, 7u);
+    EXPECT_EQ(parsed.accumulators, checkpoint.accumulators);
+}
+
+TEST(MastermindShardCheckpointTest, ShouldParseRejectCorruptedBytes) {
+    std::string bytes = mastermind::shard_checkpoint{ 1, 2, 3, 4, 5, 9, 7, { 11 } }.serialize();
+    bytes[30] ^= 1;
+
+    EXPECT_THROW(mastermind::shard_checkpoint::parse(bytes), mastermind::shard_runner_error);
+    EXPECT_THROW(mastermind::shard_checkpoint::parse(bytes.substr(0, 20)), mastermind::shard_runner_error);
+}
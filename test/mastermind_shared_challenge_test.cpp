@@ -0,0 +1,153 @@
+#include "../include/mastermind_shared_challenge.hpp"
+#include "gmock/gmock.h"
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+
+
+class MastermindSharedChallengeTest : public ::testing::Test {
+public:
+    const std::vector<int> TEST_CORRECT_SOLUTION{ { 1, 2, 3, 4, 5 } };
+    mastermind::shared_challenge<int> challenge{ TEST_CORRECT_SOLUTION, 3 };
+};
+
+
+TEST_F(MastermindSharedChallengeTest, ShouldThrowZeroMaxTriesValueErrorForZeroTries) {
+    ASSERT_THROW((mastermind::shared_challenge<int>{ TEST_CORRECT_SOLUTION, 0 }), mastermind::zero_max_tries_value_error);
+}
+
+TEST_F(MastermindSharedChallengeTest, ShouldThrowMaxTriesTooLargeErrorForTriesNotFittingPlayer) {
+    const std::uint64_t max_tries{ std::numeric_limits<std::uint32_t>::max() };
+    if (max_tries == std::numeric_limits<size_t>::max()) {
+        GTEST_SKIP();
+    }
+
+    ASSERT_THROW((mastermind::shared_challenge<int>{ TEST_CORRECT_SOLUTION, static_cast<size_t>(max_tries + 1) }), mastermind::max_tries_too_large_error);
+    EXPECT_EQ((mastermind::shared_challenge<int>{ TEST_CORRECT_SOLUTION, static_cast<size_t>(max_tries) }).join().tries_left, max_tries);
+}
+
+TEST_F(MastermindSharedChallengeTest, ShouldThrowIndistinctValuesErrorForSecretWithRepeatedElements) {
+    ASSERT_THROW((mastermind::shared_challenge<int>{ { 1, 1, 2 }, 3 }), mastermind::indistinct_values_error);
+}
+
+TEST_F(MastermindSharedChallengeTest, ShouldJoinedPlayerBeInGameWithMaxTries) {
+    mastermind::challenge_player player = challenge.join();
+
+    EXPECT_EQ(player.status, mastermind::game_status::IN_GAME);
+    EXPECT_EQ(player.tries_left, 3u);
+}
+
+TEST_F(MastermindSharedChallengeTest, ShouldCheckSolutionChargeOnlyTheGivenPlayer) {
+    mastermind::challenge_player first = challenge.join();
+    mastermind::challenge_player second = challenge.join();
+
+    auto result = challenge.check_solution(first, { 2, 1, 3, 5, 9 });
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result.value().pegs_in_right_place, 1u);
+    EXPECT_EQ(result.value().pegs_in_right_color, 3u);
+    EXPECT_EQ(first.tries_left, 2u);
+    EXPECT_EQ(second.tries_left, 3u);
+}
+
+TEST_F(MastermindSharedChallengeTest, ShouldPlayerEndAfterWinningOrRunningOutOfTries) {
+    mastermind::challenge_player winner = challenge.join();
+    mastermind::challenge_player loser = challenge.join();
+
+    EXPECT_TRUE(challenge.check_solution(winner, TEST_CORRECT_SOLUTION).value().valid);
+    for (int i{ 0 }; i < 3; ++i) {
+        challenge.check_solution(loser, { 5, 4, 3, 2, 1 });
+    }
+
+    EXPECT_EQ(winner.status, mastermind::game_status::ENDED);
+    EXPECT_EQ(loser.status, mastermind::game_status::ENDED);
+    EXPECT_FALSE(challenge.check_solution(loser, TEST_CORRECT_SOLUTION).has_value());
+}
+
+TEST_F(MastermindSharedChallengeTest, ShouldCheckSolutionsStoreErrorsPerRequest) {
+    mastermind::challenge_player player = challenge.join();
+    const std::vector<int> repeated{ { 1, 1, 2, 3, 4 } };
+    std::vector<mastermind::shared_challenge<int>::check_solution_request> requests{
+        { &player, &repeated, std::nullopt, nullptr },
+        { &player, &TEST_CORRECT_SOLUTION, std::nullopt, nullptr } };
+
+    challenge.check_solutions(requests.data(), requests.size());
+
+    EXPECT_THROW(std::rethrow_exception(requests[0].error), mastermind::indistinct_values_error);
+    EXPECT_TRUE(requests[1].result.value().valid);
+}
+
+TEST_F(MastermindSharedChallengeTest, ShouldScoreGuessesMatchComputeGameResult) {
+    std::mt19937 random{ 7 };
+    for (mastermind::code_rule rule : { mastermind::code_rule::DISTINCT_VALUES, mastermind::code_rule::REPEATED_VALUES }) {
+        for (int colors : { 8, 1000 }) {
+            std::vector<int> values(colors);
+            std::iota(values.begin(), values.end(), -3);
+            std::shuffle(values.begin(), values.end(), random);
+            std::vector<int> secret(values.begin(), values.begin() + 6);
+            if (rule == mastermind::code_rule::REPEATED_VALUES) {
+                secret[4] = secret[1];
+            }
+            mastermind::shared_challenge<int> shared{ secret, 10, rule };
+
+            std::vector<int> guesses{};
+            for (int k{ 0 }; k < 50; ++k) {
+                std::shuffle(values.begin(), values.end(), random);
+                std::vector<int> guess(values.begin(), values.begin() + 6);
+                if (rule == mastermind::code_rule::REPEATED_VALUES && k % 2 == 0) {
+                    guess[0] = guess[3] = secret[1];
+                }
+                guesses.insert(guesses.end(), guess.begin(), guess.end());
+            }
+            std::vector<mastermind::game_result> results(50);
+
+            shared.score_guesses(guesses.data(), 50, results.data());
+
+            for (size_t k{ 0 }; k < 50; ++k) {
+                std::vector<int> guess(guesses.begin() + k * 6, guesses.begin() + (k + 1) * 6);
+                auto expected = (rule == mastermind::code_rule::REPEATED_VALUES)
+                    ? mastermind::compute_game_result_with_repeats(secret, guess)
+                    : mastermind::compute_game_result(secret, guess);
+                EXPECT_EQ(results[k].pegs_in_right_place, expected.pegs_in_right_place);
+                EXPECT_EQ(results[k].pegs_in_right_color, expected.pegs_in_right_color);
+            }
+        }
+    }
+}
+
+TEST_F(MastermindSharedChallengeTest, ShouldScoreNonIntegralValues) {
+    mastermind::shared_challenge<std::string> shared{ { "red", "green", "blue" }, 5 };
+    mastermind::challenge_player player = shared.join();
+
+    auto result = shared.check_solution(player, { "green", "yellow", "blue" });
+
+    EXPECT_EQ(result.value().pegs_in_right_place, 1u);
+    EXPECT_EQ(result.value().pegs_in_right_color, 1u);
+}
+
+TEST_F(MastermindSharedChallengeTest, ShouldPlayersOnManyThreadsShareOneChallenge) {
+    const size_t threads{ 4 };
+    std::vector<std::vector<mastermind::challenge_player>> players(threads);
+    std::vector<std::thread> workers{};
+    for (size_t t{ 0 }; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            for (size_t i{ 0 }; i < 1000; ++i) {
+                players[t].push_back(challenge.join());
+                challenge.check_solution(players[t].back(), { 5, 4, 3, 2, 1 });
+                challenge.check_solution(players[t].back(), TEST_CORRECT_SOLUTION);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    for (const auto& group : players) {
+        for (const auto& player : group) {
+            EXPECT_EQ(player.status, mastermind::game_status::ENDED);
+        }
+    }
+}
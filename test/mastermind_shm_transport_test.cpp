@@ -0,0 +1,132 @@
+#include "../include/mastermind_shm_transport.hpp"
+#include "gmock/gmock.h"
+#include <cstdint>
+#include <limits>
+#include <sys/wait.h>
+
+
+class MastermindShmTransportTest : public ::testing::Test {
+public:
+    const std::vector<int> TEST_CORRECT_SOLUTION{ { 1, 2, 3, 4, 5 } };
+    const std::string name{ "/mastermind_shm_transport_test_" + std::to_string(::getpid()) + "_" +
+        ::testing::UnitTest::GetInstance()->current_test_info()->name() };
+    mastermind::shm_channel server_channel{ name, 64 };
+    mastermind::shm_channel client_channel{ name };
+    mastermind::shm_engine_server<int> server{ server_channel, [this](size_t) { return TEST_CORRECT_SOLUTION; } };
+    mastermind::shm_bot_client client{ client_channel };
+    std::atomic<bool> stop{ false };
+    std::thread server_thread{ [this]() { server.serve(stop); } };
+
+    ~MastermindShmTransportTest() {
+        stop = true;
+        server_thread.join();
+    }
+};
+
+
+TEST_F(MastermindShmTransportTest, ShouldPlayGameThroughChannel) {
+    mastermind::shm_response started = client.start_game(7, { 5, 3 });
+    mastermind::shm_response missed = client.guess(7, std::vector<int>{ 1, 3, 2, 4, 6 });
+    mastermind::shm_response won = client.guess(7, TEST_CORRECT_SOLUTION);
+
+    EXPECT_EQ(started.error, mastermind::shm_error::NONE);
+    EXPECT_EQ(started.tries_left, 3u);
+    EXPECT_EQ(missed.session, 7u);
+    EXPECT_EQ(missed.pegs_in_right_place, 2u);
+    EXPECT_EQ(missed.pegs_in_right_color, 2u);
+    EXPECT_EQ(missed.tries_left, 2u);
+    EXPECT_EQ(won.valid, 1u);
+    EXPECT_EQ(won.status, static_cast<std::uint8_t>(mastermind::game_status::ENDED));
+}
+
+TEST_F(MastermindShmTransportTest, ShouldReportEngineErrors) {
+    EXPECT_EQ(client.start_game(0, { 5, 0 }).error, mastermind::shm_error::ZERO_MAX_TRIES);
+    EXPECT_EQ(client.guess(1, std::vector<int>{ 1, 2 }).error, mastermind::shm_error::INCORRECT_CODE_SIZE);
+    client.start_game(1, { 5, 3 });
+    EXPECT_EQ(client.guess(1, std::vector<int>{ 1, 1, 2, 3, 4 }).error, mastermind::shm_error::INDISTINCT_VALUES);
+    EXPECT_EQ(client.start_game(mastermind::shm_engine_server<int>::default_max_sessions, { 5, 3 }).error, mastermind::shm_error::UNKNOWN_SESSION);
+}
+
+TEST_F(MastermindShmTransportTest, ShouldAnswerPipelinedRequestsInOrder) {
+    const size_t sessions{ 1000 };
+    size_t sent{ 0 };
+    size_t received{ 0 };
+    std::vector<mastermind::shm_response> responses{};
+
+    while (received < 2 * sessions) {
+        while (sent < 2 * sessions) {
+            std::uint32_t session = static_cast<std::uint32_t>(sent / 2);
+            mastermind::shm_request request = (sent % 2 == 0)
+                ? mastermind::make_start_game_request(session, { 5, 4 })
+                : mastermind::make_guess_request(session, TEST_CORRECT_SOLUTION);
+            if (!client.try_send(request)) {
+                break;
+            }
+            ++sent;
+        }
+        mastermind::shm_response response{};
+        while (client.try_receive(response)) {
+            responses.push_back(response);
+            ++received;
+        }
+    }
+
+    for (size_t i{ 0 }; i < responses.size(); ++i) {
+        EXPECT_EQ(responses[i].session, i / 2);
+        EXPECT_EQ(responses[i].error, mastermind::shm_error::NONE);
+        EXPECT_EQ(responses[i].valid, (i % 2 == 1) ? 1u : 0u);
+    }
+}
+
+TEST_F(MastermindShmTransportTest, ShouldGuessRequestRejectValuesThatDoNotFitInByte) {
+    EXPECT_THROW(mastermind::make_guess_request(0, std::vector<int>{ 1, 256 }), mastermind::shm_transport_error);
+}
+
+TEST_F(MastermindShmTransportTest, ShouldStartGameRequestRejectParamsThatDoNotFit) {
+    EXPECT_THROW(mastermind::make_start_game_request(0, { mastermind::shm_request::max_code_size + 1, 4 }), mastermind::shm_transport_error);
+    EXPECT_EQ(mastermind::make_start_game_request(0, { mastermind::shm_request::max_code_size, 4 }).code_size, mastermind::shm_request::max_code_size);
+    const std::uint64_t max_tries{ std::numeric_limits<std::uint32_t>::max() };
+    if (max_tries < std::numeric_limits<size_t>::max()) {
+        EXPECT_THROW(mastermind::make_start_game_request(0, { 5, static_cast<size_t>(max_tries + 1) }), mastermind::shm_transport_error);
+    }
+}
+
+TEST(MastermindShmChannelTest, ShouldRejectCapacityThatIsNotPowerOfTwo) {
+    EXPECT_THROW((mastermind::shm_channel{ "/mastermind_shm_channel_test_" + std::to_string(::getpid()), 100 }), mastermind::shm_transport_error);
+}
+
+TEST(MastermindShmChannelTest, ShouldFailToOpenMissingChannel) {
+    EXPECT_THROW(mastermind::shm_channel{ "/mastermind_shm_channel_test_missing_" + std::to_string(::getpid()) }, mastermind::shm_transport_error);
+}
+
+TEST(MastermindShmChannelTest, ShouldServeBotInAnotherProcess) {
+    const std::string name{ "/mastermind_shm_channel_test_bot_" + std::to_string(::getpid()) };
+    const std::vector<int> secret{ 4, 2, 7 };
+    mastermind::shm_channel channel{ name, 16 };
+
+    pid_t bot = ::fork();
+    if (bot == 0) {
+        try {
+            mastermind::shm_channel bot_channel{ name };
+            mastermind::shm_bot_client bot_client{ bot_channel };
+            bot_client.start_game(3, { 3, 8 });
+            mastermind::shm_response response = bot_client.guess(3, secret);
+            ::_exit(response.valid == 1 ? 0 : 1);
+        }
+        catch (...) {
+            ::_exit(2);
+        }
+    }
+
+    mastermind::shm_engine_server<int> server{ channel, [&secret](size_t) { return secret; } };
+    std::atomic<bool> stop{ false };
+    std::thread server_thread{ [&]() { server.serve(stop); } };
+    int status{ 0 };
+    pid_t waited = ::waitpid(bot, &status, 0);
+    stop = true;
+    server_thread.join();
+
+    ASSERT_EQ(waited, bot);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
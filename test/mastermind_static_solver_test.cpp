@@ -0,0 +1,59 @@
+#include "../include/mastermind_static_solver.hpp"
+#include "gmock/gmock.h"
+
+
+class MastermindStaticSolverTest : public ::testing::Test {
+public:
+    const std::vector<int> CODE_SET{ { 1, 2, 3, 4, 5, 6 } };
+    const mastermind::game_start_params PARAMS{ 3, 10 };
+    mastermind::static_solver_options options{ 2, 5000, 42 };
+};
+
+
+TEST_F(MastermindStaticSolverTest, ShouldSolveReturnGuessSetThatIdentifiesEverySecret) {
+    mastermind::static_solver<int> solver{ CODE_SET, PARAMS, options };
+
+    auto guesses = solver.solve();
+
+    EXPECT_GE(guesses.size(), solver.get_lower_bound());
+    for (const auto& guess : guesses) {
+        EXPECT_EQ(guess.size(), PARAMS.code_size);
+        EXPECT_TRUE(mastermind::are_all_values_different(guess));
+    }
+    EXPECT_TRUE(solver.verify(guesses));
+}
+
+TEST_F(MastermindStaticSolverTest, ShouldSolveBeDeterministicForTheSameSeed) {
+    mastermind::static_solver<int> first{ CODE_SET, PARAMS, options };
+    mastermind::static_solver<int> second{ CODE_SET, PARAMS, options };
+
+    EXPECT_EQ(first.solve(), second.solve());
+}
+
+TEST_F(MastermindStaticSolverTest, ShouldVerifyRejectGuessSetThatLeavesSecretsAmbiguous) {
+    mastermind::static_solver<int> solver{ CODE_SET, PARAMS, options };
+
+    EXPECT_FALSE(solver.verify({}));
+    EXPECT_FALSE(solver.verify({ { 1, 2, 3 } }));
+}
+
+TEST_F(MastermindStaticSolverTest, ShouldVerifyAcceptEveryCodeAsGuessSet) {
+    mastermind::static_solver<int> solver{ { 1, 2, 3 }, { 2, 10 }, options };
+
+    EXPECT_TRUE(solver.verify({ { 1, 2 }, { 1, 3 }, { 2, 1 }, { 2, 3 }, { 3, 1 } }));
+    EXPECT_FALSE(solver.verify({ { 1, 2 } }));
+}
+
+TEST_F(MastermindStaticSolverTest, ShouldVerifyThrowForInvalidGuesses) {
+    mastermind::static_solver<int> solver{ CODE_SET, PARAMS, options };
+
+    EXPECT_THROW(solver.verify({ { 1, 2 } }), mastermind::incorrect_code_size_error);
+    EXPECT_THROW(solver.verify({ { 1, 1, 2 } }), mastermind::indistinct_values_error);
+    EXPECT_THROW(solver.verify({ { 1, 2, 9 } }), mastermind::value_not_in_code_set_error);
+}
+
+TEST_F(MastermindStaticSolverTest, ShouldLowerBoundFollowFromTheNumberOfFeedbacks) {
+    mastermind::static_solver<int> solver{ CODE_SET, PARAMS, options };
+
+    EXPECT_EQ(solver.get_lower_bound(), 3u);
+}
@@ -1,5 +1,7 @@
 #include "../include/mastermind_utils.hpp"
 #include "gmock/gmock.h"
+#include <random>
+#include <string>
 
 
 TEST(MastermindUtilsTest, ShouldAreAllValuesDifferentReturnTrueForDistinctValues) {
@@ -9,3 +11,73 @@ TEST(MastermindUtilsTest, ShouldAreAllValuesDifferentReturnTrueForDistinctValues
 TEST(MastermindUtilsTest, ShouldAreAllValuesDifferentReturnFalseForIndistinctValues) {
     EXPECT_FALSE(mastermind::are_all_values_different<int>({ 1, 2, 3, 3 }));
 }
+
+TEST(MastermindUtilsTest, ShouldComputeGameResultWithRepeatsCountEachPegOnce) {
+    auto result = mastermind::compute_game_result_with_repeats<int>({ 1, 1, 2, 2 }, { 1, 2, 1, 1 });
+
+    EXPECT_FALSE(result.valid);
+    EXPECT_EQ(result.pegs_in_right_place, 1u);
+    EXPECT_EQ(result.pegs_in_right_color, 2u);
+}
+
+TEST(MastermindUtilsTest, ShouldComputeGameResultWithRepeatsBeValidForEqualCodes) {
+    auto result = mastermind::compute_game_result_with_repeats<int>({ 3, 3, 3 }, { 3, 3, 3 });
+
+    EXPECT_TRUE(result.valid);
+    EXPECT_EQ(result.pegs_in_right_place, 3u);
+    EXPECT_EQ(result.pegs_in_right_color, 0u);
+}
+
+TEST(MastermindUtilsTest, ShouldComputeGameResultWithRepeatsAgreeWithComputeGameResultForDistinctValues) {
+    std::vector<int> secret{ 4, 9, 1, 7, 2 };
+    std::vector<int> guess{ 9, 4, 1, 3, 8 };
+
+    auto expected = mastermind::compute_game_result(secret, guess);
+    auto result = mastermind::compute_game_result_with_repeats(secret, guess);
+
+    EXPECT_EQ(result.pegs_in_right_place, expected.pegs_in_right_place);
+    EXPECT_EQ(result.pegs_in_right_color, expected.pegs_in_right_color);
+}
+
+TEST(MastermindUtilsTest, ShouldComputeGameResultWithRepeatsAgreeAcrossValueRanges) {
+    std::mt19937 g{ 7 };
+    for (long long colors : { 6LL, 40LL, 1000LL }) {
+        std::uniform_int_distribution<long long> any_value{ -colors / 2, colors - colors / 2 - 1 };
+        for (size_t size : { 1u, 4u, 9u, 33u }) {
+            for (int round{ 0 }; round < 50; ++round) {
+                std::vector<long long> secret(size);
+                std::vector<long long> guess(size);
+                for (size_t i{ 0 }; i < size; ++i) {
+                    secret[i] = any_value(g);
+                    guess[i] = any_value(g);
+                }
+                std::vector<std::string> secret_text{};
+                std::vector<std::string> guess_text{};
+                for (size_t i{ 0 }; i < size; ++i) {
+                    secret_text.push_back(std::to_string(secret[i]));
+                    guess_text.push_back(std::to_string(guess[i]));
+                }
+
+                auto result = mastermind::compute_game_result_with_repeats(secret, guess);
+                auto expected = mastermind::compute_game_result_with_repeats(secret_text, guess_text);
+
+                EXPECT_EQ(result.pegs_in_right_place, expected.pegs_in_right_place);
+                EXPECT_EQ(result.pegs_in_right_color, expected.pegs_in_right_color);
+            }
+        }
+    }
+}
+
+TEST(MastermindUtilsTest, ShouldComputeGameResultHandleCodesOfDifferentSizes) {
+    const std::vector<int> secret{ 1, 2, 3 };
+
+    auto longer = mastermind::compute_game_result(secret, std::vector<int>{ 1, 3, 2, 7, 8 });
+    auto shorter = mastermind::compute_game_result(secret, std::vector<int>{ 1, 2 });
+
+    EXPECT_FALSE(longer.valid);
+    EXPECT_EQ(longer.pegs_in_right_place, 1u);
+    EXPECT_EQ(longer.pegs_in_right_color, 2u);
+    EXPECT_FALSE(shorter.valid);
+    EXPECT_EQ(shorter.pegs_in_right_place, 2u);
+    EXPECT_FALSE(mastermind::compute_game_result_with_repeats(secret, std::vector<int>{ 1, 2, 3, 3 }).valid);
+}
@@ -0,0 +1,119 @@
+#include "../include/mastermind_engine.hpp"
+#include "../include/mastermind_game.hpp"
+#include "../ui/win_cmd_ui/win_cmd_script_ui.hpp"
+#include "gmock/gmock.h"
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+
+
+class WinCmdScriptUiTest : public ::testing::Test {
+public:
+    std::string path{ ::testing::TempDir() + "win_cmd_script_ui_test_" +
+        ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".txt" };
+    std::FILE* output{ std::tmpfile() };
+
+    WinCmdScriptUiTest() { std::remove(path.c_str()); }
+    ~WinCmdScriptUiTest() {
+        std::fclose(output);
+        std::remove(path.c_str());
+    }
+
+    std::unique_ptr<win_cmd_script_ui> make_ui(const std::string& script) {
+        std::ofstream{ path, std::ios::binary } << script;
+        return std::make_unique<win_cmd_script_ui>(path, 8, 5, output);
+    }
+
+    std::string get_output() {
+        std::string text{};
+        std::rewind(output);
+        for (int c; (c = std::fgetc(output)) != EOF;) {
+            text.push_back(static_cast<char>(c));
+        }
+        return text;
+    }
+};
+
+
+TEST_F(WinCmdScriptUiTest, ShouldParseGuessesSeparatedByBlanks) {
+    auto ui = make_ui("1 2  3\t4 5\r\n6 7 8 9 10");
+
+    EXPECT_THAT(ui->ask_for_solution(), ElementsAre(1, 2, 3, 4, 5));
+    EXPECT_THAT(ui->ask_for_solution(), ElementsAre(6, 7, 8, 9, 10));
+    EXPECT_THAT(ui->ask_for_solution(), IsEmpty());
+}
+
+TEST_F(WinCmdScriptUiTest, ShouldStopParsingGuessAtFirstValueThatIsNotANumber) {
+    auto ui = make_ui("1 2 x 4 5\n");
+
+    EXPECT_THAT(ui->ask_for_solution(), ElementsAre(1, 2));
+}
+
+TEST_F(WinCmdScriptUiTest, ShouldAnswerPlayAgainFromScript) {
+    auto ui = make_ui("Y\n\n  no \n");
+
+    EXPECT_TRUE(ui->ask_play_again());
+    EXPECT_FALSE(ui->ask_play_again());
+}
+
+TEST_F(WinCmdScriptUiTest, ShouldPlayAgainWithoutConsumingNextGuess) {
+    auto ui = make_ui("\n1 2 3 4 5\n");
+
+    EXPECT_TRUE(ui->ask_play_again());
+    EXPECT_THAT(ui->ask_for_solution(), ElementsAre(1, 2, 3, 4, 5));
+}
+
+TEST_F(WinCmdScriptUiTest, ShouldNotPlayAgainAtEndOfScript) {
+    auto ui = make_ui("1 2 3 4 5\n\n \n");
+
+    ui->ask_for_solution();
+    EXPECT_FALSE(ui->ask_play_again());
+}
+
+TEST_F(WinCmdScriptUiTest, ShouldBufferTranscriptUntilFlush) {
+    auto ui = make_ui("");
+
+    ui->show_tries_left(8);
+    ui->show_game_result({ false, 2, 1 });
+    EXPECT_THAT(get_output(), IsEmpty());
+
+    ui->flush();
+    EXPECT_EQ(get_output(), "Tries left: 8\nCORRECT: 2 COLOR: 1\n");
+}
+
+TEST_F(WinCmdScriptUiTest, ShouldWriteTranscriptBeforeGameErrorIsReported) {
+    auto ui = make_ui("5 4 3 2 1\n1 2 3\n");
+    mastermind::mastermind_game<mastermind::mastermind_engine<int>> game{ *ui, [](size_t) { return std::vector<int>{ 1, 2, 3, 4, 5 }; } };
+
+    EXPECT_THROW(game.run(), mastermind::incorrect_code_size_error);
+    ui.reset();
+
+    EXPECT_EQ(get_output(),
+        "Tries left: 8\nPlease enter your solution below\nCORRECT: 1 COLOR: 4\n"
+        "Tries left: 7\nPlease enter your solution below\n");
+}
+
+TEST_F(WinCmdScriptUiTest, ShouldThrowWhenTranscriptCannotBeWritten) {
+    std::ofstream{ path + ".out" };
+    std::FILE* read_only = std::fopen((path + ".out").c_str(), "r");
+    ASSERT_NE(read_only, nullptr);
+    std::ofstream{ path, std::ios::binary };
+    {
+        win_cmd_script_ui ui{ path, 8, 5, read_only };
+        ui.show_winning_message();
+
+        EXPECT_THROW(ui.flush(), std::runtime_error);
+    }
+    std::fclose(read_only);
+    std::remove((path + ".out").c_str());
+}
+
+TEST_F(WinCmdScriptUiTest, ShouldThrowWhenScriptCannotBeOpened) {
+    EXPECT_THROW(win_cmd_script_ui(path, 8, 5, output), std::runtime_error);
+}
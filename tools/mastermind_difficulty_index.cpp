@@ -0,0 +1,34 @@
+#include "mastermind_difficulty_index.hpp"
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <thread>
+
+
+// Builds the difficulty index of a board, saves it to the given file and prints how
+// many secrets need each number of guesses.
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " <index file> <colors> <code size> [threads]\n";
+        return 2;
+    }
+
+    const size_t colors = static_cast<size_t>(std::strtoul(argv[2], nullptr, 10));
+    const size_t code_size = static_cast<size_t>(std::strtoul(argv[3], nullptr, 10));
+    const size_t threads = (argc > 4) ? static_cast<size_t>(std::strtoul(argv[4], nullptr, 10)) : std::thread::hardware_concurrency();
+
+    try {
+        mastermind::difficulty_index index = mastermind::difficulty_index::build({ colors, code_size }, threads);
+        index.save(argv[1]);
+
+        for (size_t d{ 1 }; d <= index.get_max_difficulty(); ++d) {
+            const auto band = static_cast<std::uint8_t>(d);
+            std::cout << "solved in " << d << ": " << index.count({ band, band }) << '\n';
+        }
+    }
+    catch (const std::exception& error) {
+        std::cerr << error.what() << '\n';
+        return 2;
+    }
+}
@@ -0,0 +1,37 @@
+#include "mastermind_game_log.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <thread>
+
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <game log> [threads]\n";
+        return 2;
+    }
+
+    size_t threads = (argc > 2) ? static_cast<size_t>(std::strtoul(argv[2], nullptr, 10)) : std::thread::hardware_concurrency();
+
+    try {
+        mastermind::game_log_reader reader{ argv[1] };
+
+        auto begin = std::chrono::steady_clock::now();
+        mastermind::game_log_replay_result result = mastermind::replay_game_log(reader.records(), reader.size(), threads);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+        std::cout << "games: " << result.games << '\n'
+            << "guesses: " << result.guesses << '\n'
+            << "mismatches: " << result.mismatches << '\n'
+            << "malformed records: " << result.malformed_records << '\n'
+            << "guesses per second: " << static_cast<double>(result.guesses) / elapsed.count() << '\n';
+
+        return (result.mismatches == 0 && result.malformed_records == 0) ? 0 : 1;
+    }
+    catch (const std::exception& error) {
+        std::cerr << error.what() << '\n';
+        return 2;
+    }
+}
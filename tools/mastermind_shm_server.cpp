@@ -0,0 +1,54 @@
+#include "mastermind_basic_code_pattern_generator.hpp"
+#include "mastermind_exceptions.hpp"
+#include "mastermind_shm_transport.hpp"
+
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <numeric>
+
+
+namespace {
+
+    std::atomic<bool> stop_requested{ false };
+
+    extern "C" void request_stop(int) {
+        stop_requested = true;
+    }
+
+}
+
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <channel name> [colors] [ring capacity]\n";
+        return 2;
+    }
+
+    size_t colors = (argc > 2) ? static_cast<size_t>(std::strtoul(argv[2], nullptr, 10)) : 8;
+    size_t capacity = (argc > 3) ? static_cast<size_t>(std::strtoul(argv[3], nullptr, 10)) : mastermind::shm_channel::default_capacity;
+    std::vector<int> code_set(std::min<size_t>(colors, 256));
+    std::iota(code_set.begin(), code_set.end(), 0);
+
+    try {
+        mastermind::basic_code_pattern_generator<int> code_gen{ code_set };
+        mastermind::shm_channel channel{ argv[1], capacity };
+        mastermind::shm_engine_server<int> server{ channel, [&](size_t code_size) {
+            if (code_size > code_set.size()) {
+                throw mastermind::code_set_too_small_error{ code_size, code_set.size() };
+            }
+            return code_gen(code_size);
+        } };
+
+        std::signal(SIGINT, request_stop);
+        std::signal(SIGTERM, request_stop);
+        std::cout << "serving " << argv[1] << std::endl;
+        server.serve(stop_requested);
+    }
+    catch (const std::exception& error) {
+        std::cerr << error.what() << '\n';
+        return 2;
+    }
+}
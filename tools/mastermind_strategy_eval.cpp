@@ -0,0 +1,66 @@
+#include "mastermind_code_space.hpp"
+#include "mastermind_sampling_solver.hpp"
+#include "mastermind_shard_runner.hpp"
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <numeric>
+
+
+// Plays the sampling solver against every secret of a board and prints how many games
+// took each number of guesses. Progress is checkpointed per shard in the given
+// directory; running the same command again resumes an interrupted evaluation.
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " <checkpoint directory> <colors> <code size> [max tries] [shards] [workers]\n";
+        return 2;
+    }
+
+    const size_t colors = static_cast<size_t>(std::strtoul(argv[2], nullptr, 10));
+    const size_t code_size = static_cast<size_t>(std::strtoul(argv[3], nullptr, 10));
+    const size_t max_tries = (argc > 4) ? static_cast<size_t>(std::strtoul(argv[4], nullptr, 10)) : 12;
+    mastermind::shard_runner_options options{};
+    if (argc > 5) {
+        options.shards = static_cast<size_t>(std::strtoul(argv[5], nullptr, 10));
+    }
+    if (argc > 6) {
+        options.workers = static_cast<size_t>(std::strtoul(argv[6], nullptr, 10));
+    }
+    options.checkpoint_interval = 256;
+
+    try {
+        std::vector<size_t> code_set(colors);
+        std::iota(code_set.begin(), code_set.end(), 0);
+        mastermind::code_space space{ colors, code_size };
+        const size_t sample_size{ 64 };
+        const std::uint64_t job_key = (std::uint64_t{ colors } << 48) ^ (std::uint64_t{ code_size } << 32) ^ (std::uint64_t{ max_tries } << 16) ^ sample_size;
+
+        mastermind::shard_runner runner{ argv[1], job_key, space.size(), max_tries + 1, options };
+        std::vector<std::uint64_t> histogram = runner.run([&](std::uint64_t first, std::uint64_t last, std::uint64_t* accumulators) {
+            for (std::uint64_t r{ first }; r < last; ++r) {
+                const std::vector<size_t> secret = space.unrank(r);
+                mastermind::sampling_solver<size_t> solver{ code_set, { code_size, max_tries }, sample_size, static_cast<std::uint_fast32_t>(r) };
+                size_t tries{ 0 };
+                for (; tries < max_tries; ++tries) {
+                    std::vector<size_t> guess = solver.next_guess();
+                    mastermind::game_result result = mastermind::compute_game_result(secret, guess);
+                    if (result.valid) {
+                        break;
+                    }
+                    solver.add_feedback(guess, result);
+                }
+                ++accumulators[tries];
+            }
+        });
+
+        for (size_t tries{ 0 }; tries < max_tries; ++tries) {
+            std::cout << "solved in " << tries + 1 << ": " << histogram[tries] << '\n';
+        }
+        std::cout << "unsolved: " << histogram[max_tries] << '\n';
+    }
+    catch (const std::exception& error) {
+        std::cerr << error.what() << '\n';
+        return 2;
+    }
+}
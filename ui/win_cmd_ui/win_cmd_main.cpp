@@ -1,24 +1,87 @@
 #include "mastermind_basic_code_pattern_generator.hpp"
 #include "mastermind_engine.hpp"
 #include "mastermind_game.hpp"
+#include "win_cmd_script_ui.hpp"
 #include "win_cmd_ui.hpp"
+#ifndef _WIN32
+#include "mastermind_game_log.hpp"
+#endif
 
 #include <exception>
 #include <iostream>
+#include <memory>
 #include <numeric>
+#include <string>
 
 
-int main() {
+int main(int argc, char** argv) {
     std::vector<int> code_set(8);
     std::iota(code_set.begin(), code_set.end(), 1);
 
+#ifndef _WIN32
+    const std::string options{ " [--script <path>|-] [--log <path>]" };
+    const bool log_supported{ true };
+#else
+    const std::string options{ " [--script <path>|-]" };
+    const bool log_supported{ false };
+#endif
+
+    std::string script_path{};
+    std::string log_path{};
+    for (int i{ 1 }; i < argc; i += 2) {
+        std::string option{ argv[i] };
+        if ((option != "--script" && (option != "--log" || !log_supported)) || i + 1 >= argc) {
+            std::cerr << "Usage: " << argv[0] << options << std::endl;
+            return 2;
+        }
+        if (option == "--script") {
+            script_path = argv[i + 1];
+        }
+        else {
+            log_path = argv[i + 1];
+        }
+    }
+
     try {
         mastermind::basic_code_pattern_generator code_gen{ code_set };
-        win_cmd_ui ui{ 8, 5 };
-        mastermind::mastermind_game<mastermind::mastermind_engine<int>> game{ ui, std::bind(&mastermind::basic_code_pattern_generator<int>::operator(), &code_gen, std::placeholders::_1) };
+        std::unique_ptr<mastermind::mastermind_ui<int>> ui{};
+        win_cmd_script_ui* script_ui{ nullptr };
+        if (script_path.empty()) {
+            ui = std::make_unique<win_cmd_ui>(8, 5);
+        }
+        else {
+            ui = std::make_unique<win_cmd_script_ui>(script_path, 8, 5);
+            script_ui = static_cast<win_cmd_script_ui*>(ui.get());
+        }
+        mastermind::mastermind_game<mastermind::mastermind_engine<int>> game{ *ui, std::bind(&mastermind::basic_code_pattern_generator<int>::operator(), &code_gen, std::placeholders::_1) };
+
+#ifndef _WIN32
+        std::unique_ptr<mastermind::game_log_writer> log_writer{};
+        std::unique_ptr<mastermind::game_log_recorder<int>> log_recorder{};
+        if (!log_path.empty()) {
+            log_writer = std::make_unique<mastermind::game_log_writer>(log_path);
+            log_recorder = std::make_unique<mastermind::game_log_recorder<int>>(*log_writer);
+            game.set_observer(log_recorder.get());
+        }
+#endif
+
         game.run();
+        if (script_ui != nullptr) {
+            script_ui->flush();
+        }
+#ifndef _WIN32
+        if (log_recorder && log_recorder->get_skipped_games() > 0) {
+            std::cerr << log_recorder->get_skipped_games() << " game(s) not logged, last because "
+                << log_recorder->get_last_skip_reason() << std::endl;
+        }
+#endif
     }
     catch (const std::logic_error& error) {
         std::cout << error.what() << std::endl;
+        return 1;
+    }
+    catch (const std::runtime_error& error) {
+        std::cout << error.what() << std::endl;
+        return 1;
     }
-}
\ No newline at end of file
+}
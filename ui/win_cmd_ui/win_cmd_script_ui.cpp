@@ -0,0 +1,233 @@
+#include "win_cmd_script_ui.hpp"
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <sstream>
+#endif
+
+
+namespace {
+
+    bool is_blank(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    std::string_view trim(std::string_view text) {
+        while (!text.empty() && is_blank(text.front())) {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && is_blank(text.back())) {
+            text.remove_suffix(1);
+        }
+        return text;
+    }
+
+    bool equals_ignoring_case(std::string_view text, std::string_view word) {
+        if (text.size() != word.size()) {
+            return false;
+        }
+        for (size_t i{ 0 }; i < text.size(); ++i) {
+            char c = (text[i] >= 'A' && text[i] <= 'Z') ? static_cast<char>(text[i] - 'A' + 'a') : text[i];
+            if (c != word[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+}
+
+
+win_cmd_script_ui::win_cmd_script_ui(const std::string& script_path, size_t max_tries, size_t code_size, std::FILE* output)
+    : m_max_tries{ max_tries }, m_code_size{ code_size }, m_output{ output } {
+    m_buffer.reserve(2 * output_chunk);
+
+#ifndef _WIN32
+    int fd = (script_path == "-") ? STDIN_FILENO : ::open(script_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error{ "Cannot open script " + script_path + ": " + std::strerror(errno) };
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void* data = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            ::madvise(data, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+            m_data = static_cast<const char*>(data);
+            m_length = static_cast<size_t>(st.st_size);
+            m_mapped = true;
+        }
+    }
+
+    if (!m_mapped) {
+        char chunk[1 << 16];
+        for (ssize_t n; (n = ::read(fd, chunk, sizeof(chunk))) != 0;) {
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            m_copy.append(chunk, static_cast<size_t>(n));
+        }
+        m_data = m_copy.data();
+        m_length = m_copy.size();
+    }
+
+    if (fd != STDIN_FILENO) {
+        ::close(fd);
+    }
+#else
+    std::ifstream file{ script_path, std::ios::binary };
+    if (!file) {
+        throw std::runtime_error{ "Cannot open script " + script_path };
+    }
+    std::ostringstream content{};
+    content << file.rdbuf();
+    m_copy = content.str();
+    m_data = m_copy.data();
+    m_length = m_copy.size();
+#endif
+}
+
+void win_cmd_script_ui::show_board() {
+}
+
+void win_cmd_script_ui::show_tries_left(size_t tries_left) {
+    write("Tries left: ");
+    write(tries_left);
+    write("\n");
+}
+
+void win_cmd_script_ui::show_game_result(mastermind::game_result result) {
+    write("CORRECT: ");
+    write(result.pegs_in_right_place);
+    write(" COLOR: ");
+    write(result.pegs_in_right_color);
+    write("\n");
+}
+
+void win_cmd_script_ui::show_lost_message() {
+    write("GAME LOST!\n");
+}
+
+void win_cmd_script_ui::show_winning_message() {
+    write("YOU WIN!\n");
+}
+
+mastermind::game_start_params win_cmd_script_ui::get_start_params() {
+    return { m_code_size, m_max_tries };
+}
+
+std::vector<int> win_cmd_script_ui::ask_for_solution() {
+    write("Please enter your solution below\n");
+    std::vector<int> tmp{};
+    tmp.reserve(m_code_size);
+
+    std::string_view line = next_line();
+    const char* first = line.data();
+    const char* last = line.data() + line.size();
+    while (true) {
+        while (first != last && is_blank(*first)) {
+            ++first;
+        }
+        int value{};
+        auto [end, error] = std::from_chars(first, last, value);
+        if (error != std::errc{}) {
+            break;
+        }
+        tmp.push_back(value);
+        first = end;
+    }
+
+    return tmp;
+}
+
+bool win_cmd_script_ui::ask_play_again() {
+    write("Play again? (T/N): ");
+    if (!skip_blank_lines()) {
+        return false;
+    }
+
+    size_t position = m_position;
+    std::string_view answer = trim(next_line());
+    if (equals_ignoring_case(answer, "y") || equals_ignoring_case(answer, "yes")) {
+        return true;
+    }
+    if (equals_ignoring_case(answer, "n") || equals_ignoring_case(answer, "no")) {
+        return false;
+    }
+
+    m_position = position;
+    return true;
+}
+
+win_cmd_script_ui::~win_cmd_script_ui() {
+    try {
+        flush();
+    }
+    catch (const std::runtime_error&) {
+    }
+#ifndef _WIN32
+    if (m_mapped) {
+        ::munmap(const_cast<char*>(m_data), m_length);
+    }
+#endif
+}
+
+void win_cmd_script_ui::flush() {
+    if (!m_buffer.empty()) {
+        size_t size = m_buffer.size();
+        size_t written = std::fwrite(m_buffer.data(), 1, size, m_output);
+        m_buffer.clear();
+        if (written != size) {
+            throw std::runtime_error{ "Cannot write transcript: " + std::string{ std::strerror(errno) } };
+        }
+    }
+}
+
+std::string_view win_cmd_script_ui::next_line() {
+    if (m_position >= m_length) {
+        return {};
+    }
+    const char* begin = m_data + m_position;
+    const void* newline = std::memchr(begin, '\n', m_length - m_position);
+    size_t size = (newline != nullptr) ? static_cast<size_t>(static_cast<const char*>(newline) - begin) : m_length - m_position;
+    m_position += size + ((newline != nullptr) ? 1 : 0);
+    return { begin, size };
+}
+
+bool win_cmd_script_ui::skip_blank_lines() {
+    while (m_position < m_length) {
+        size_t position = m_position;
+        if (!trim(next_line()).empty()) {
+            m_position = position;
+            return true;
+        }
+    }
+    return false;
+}
+
+void win_cmd_script_ui::write(std::string_view text) {
+    m_buffer.append(text.data(), text.size());
+    if (m_buffer.size() >= output_chunk) {
+        flush();
+    }
+}
+
+void win_cmd_script_ui::write(size_t value) {
+    char digits[24];
+    auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value);
+    write(std::string_view{ digits, static_cast<size_t>(end - digits) });
+}
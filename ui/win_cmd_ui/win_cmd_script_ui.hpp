@@ -0,0 +1,49 @@
+#pragma once
+
+#include<mastermind_ui.hpp>
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+
+// Console front-end for scripted load tests: the whole script of guesses is mapped
+// (or read, for pipes) up front and the transcript is buffered and written in large
+// chunks, never flushed per message. Script lines are the ones typed in interactive
+// mode; between games an optional y/yes/n/no line answers the play again question,
+// otherwise a new game starts while the script has lines left.
+class win_cmd_script_ui : public mastermind::mastermind_ui<int> {
+public:
+    win_cmd_script_ui(const std::string& script_path, size_t max_tries, size_t code_size, std::FILE* output = stdout);
+    win_cmd_script_ui(const win_cmd_script_ui&) = delete;
+    win_cmd_script_ui& operator=(const win_cmd_script_ui&) = delete;
+    virtual void show_board();
+    virtual void show_tries_left(size_t);
+    virtual void show_game_result(mastermind::game_result);
+    virtual void show_lost_message();
+    virtual void show_winning_message();
+    virtual mastermind::game_start_params get_start_params();
+    virtual std::vector<int> ask_for_solution();
+    virtual bool ask_play_again();
+    virtual ~win_cmd_script_ui();
+
+    void flush();
+
+private:
+    static constexpr size_t output_chunk{ 1 << 16 };
+
+    size_t m_max_tries{ 8 };
+    size_t m_code_size{ 5 };
+    std::FILE* m_output;
+    std::string m_buffer{};
+    const char* m_data{ nullptr };
+    size_t m_length{ 0 };
+    bool m_mapped{ false };
+    std::string m_copy{};
+    size_t m_position{ 0 };
+
+    std::string_view next_line();
+    bool skip_blank_lines();
+    void write(std::string_view text);
+    void write(size_t value);
+};